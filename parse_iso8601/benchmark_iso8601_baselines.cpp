@@ -0,0 +1,190 @@
+// Throughput of parse_iso8601datetime compared with date::parse, std::chrono::parse and
+// strptime + timegm on generated corpora. Each benchmark reports the time per parse and bytes/s;
+// 'valid' is the share of strings accepted by the parser, which should be 1 for all corpora except
+// the invalid one.
+
+#include "iso8601_corpus.h"
+#include "parse_iso8601.h"
+
+#include <benchmark/benchmark.h>
+#include <date/date.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define ISO8601_HAS_STRPTIME 1
+#endif
+
+using namespace core::time;
+
+namespace {
+
+constexpr std::size_t corpus_size{ 1000 };
+
+using microseconds_point = time_point<std::chrono::microseconds>;
+
+// format string for date::parse and std::chrono::parse
+const char* chrono_format(iso8601_corpus_kind kind)
+{
+    switch (kind)
+    {
+    case iso8601_corpus_kind::basic:
+        return "%Y%m%dT%H%M%SZ";
+    case iso8601_corpus_kind::offset:
+        return "%FT%T%Ez";
+    default:
+        return "%FT%TZ";
+    }
+}
+
+struct iso8601_parser
+{
+    bool operator()(const std::string& date, iso8601_corpus_kind, microseconds_point& result)
+    {
+        return !try_parse_iso8601datetime(date, result);
+    }
+};
+
+struct date_parser
+{
+    std::istringstream stream;
+
+    bool operator()(const std::string& date, iso8601_corpus_kind kind, microseconds_point& result)
+    {
+        stream.clear();
+        stream.str(date);
+        stream >> date::parse(chrono_format(kind), result);
+        return !stream.fail();
+    }
+};
+
+#if defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+struct std_chrono_parser
+{
+    std::istringstream stream;
+
+    bool operator()(const std::string& date, iso8601_corpus_kind kind, microseconds_point& result)
+    {
+        stream.clear();
+        stream.str(date);
+        stream >> std::chrono::parse(chrono_format(kind), result);
+        return !stream.fail();
+    }
+};
+#endif
+
+#if defined(ISO8601_HAS_STRPTIME)
+// strptime has no fraction conversion, so the fraction is read by hand
+struct strptime_parser
+{
+    bool operator()(const std::string& date, iso8601_corpus_kind kind, microseconds_point& result)
+    {
+        const char* format{ kind == iso8601_corpus_kind::basic    ? "%Y%m%dT%H%M%S"
+                            : kind == iso8601_corpus_kind::offset ? "%Y-%m-%dT%H:%M:%S%z"
+                                                                  : "%Y-%m-%dT%H:%M:%S" };
+        std::tm     tm{};
+        const char* p{ strptime(date.c_str(), format, &tm) };
+        if (p == nullptr)
+            return false;
+
+        long microseconds{ 0 };
+        if (*p == '.')
+        {
+            long scale{ 1000000 };
+            for (++p; *p >= '0' && *p <= '9'; ++p)
+                microseconds += (*p - '0') * (scale /= 10);
+        }
+        if (kind != iso8601_corpus_kind::offset && *p++ != 'Z')
+            return false;
+        if (*p != '\0')
+            return false;
+
+        const std::time_t seconds{ timegm(&tm) - tm.tm_gmtoff };
+        result = microseconds_point{ std::chrono::seconds{ seconds } +
+                                     std::chrono::microseconds{ microseconds } };
+        return true;
+    }
+};
+#endif
+
+template <typename Parser>
+void parse_corpus(benchmark::State& state, iso8601_corpus_kind kind)
+{
+    const auto corpus{ generate_iso8601_corpus(kind, corpus_size) };
+
+    Parser      parser;
+    std::size_t bytes{ 0 };
+    std::size_t valid{ 0 };
+    for (const auto& date : corpus)
+    {
+        microseconds_point result;
+        bytes += date.size();
+        valid += parser(date, kind, result) ? 1 : 0;
+    }
+
+    for (auto _ : state)
+    {
+        for (const auto& date : corpus)
+        {
+            microseconds_point result;
+            benchmark::DoNotOptimize(parser(date, kind, result));
+            benchmark::DoNotOptimize(result);
+        }
+    }
+
+    const auto iterations{ static_cast<std::int64_t>(state.iterations()) };
+    state.SetItemsProcessed(iterations * static_cast<std::int64_t>(corpus.size()));
+    state.SetBytesProcessed(iterations * static_cast<std::int64_t>(bytes));
+    state.counters["time/parse"] =
+        benchmark::Counter(static_cast<double>(corpus.size()),
+                           benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.counters["valid"] = static_cast<double>(valid) / static_cast<double>(corpus.size());
+}
+
+void register_benchmarks()
+{
+    struct
+    {
+        iso8601_corpus_kind kind;
+        const char*         name;
+    } const corpora[]{
+        { iso8601_corpus_kind::canonical, "canonical" },   { iso8601_corpus_kind::basic, "basic" },
+        { iso8601_corpus_kind::fractional, "fractional" }, { iso8601_corpus_kind::offset, "offset" },
+        { iso8601_corpus_kind::invalid, "invalid" },
+    };
+    for (const auto& corpus : corpora)
+    {
+        const std::string suffix{ std::string{ "/" } + corpus.name };
+        benchmark::RegisterBenchmark(("parse_iso8601datetime" + suffix).c_str(),
+                                     parse_corpus<iso8601_parser>, corpus.kind);
+        benchmark::RegisterBenchmark(("date::parse" + suffix).c_str(), parse_corpus<date_parser>,
+                                     corpus.kind);
+#if defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+        benchmark::RegisterBenchmark(("std::chrono::parse" + suffix).c_str(),
+                                     parse_corpus<std_chrono_parser>, corpus.kind);
+#endif
+#if defined(ISO8601_HAS_STRPTIME)
+        benchmark::RegisterBenchmark(("strptime+timegm" + suffix).c_str(),
+                                     parse_corpus<strptime_parser>, corpus.kind);
+#endif
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    register_benchmarks();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,839 @@
+// Throughput of the library's own variants compared with each other: batch, parallel, cached,
+// sequential, compile-time format and table-driven parsing, validation, scanning and formatting.
+// Linked into benchmark_iso8601_baselines, which provides main; select a group with
+// --benchmark_filter, e.g. --benchmark_filter=cache. Each benchmark reports items/s, an item being
+// one string or time point.
+
+#include "find_iso8601.h"
+#include "format_iso8601.h"
+#include "format_iso8601_batch.h"
+#include "iso8601_cache.h"
+#include "iso8601_corpus.h"
+#include "iso8601_delta_column.h"
+#include "iso8601_incremental_parser.h"
+#include "iso8601_range_filter.h"
+#include "iso8601_sequential_parser.h"
+#include "parse_iso8601.h"
+#include "parse_iso8601_batch.h"
+#include "parse_iso8601_buckets.h"
+#include "parse_iso8601_column.h"
+#include "parse_iso8601_fields.h"
+#include "parse_iso8601_format.h"
+#include "parse_iso8601_parallel.h"
+#include "parse_iso8601_view.h"
+
+#include <benchmark/benchmark.h>
+#include <date/date.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <random>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+// generates random date and time strings in 'YYYY-MM-DDThh:mm:ss<fraction><suffix>' layout
+std::vector<std::string> generate_datetimes(const char* fraction, const char* suffix, bool basic = false)
+{
+    std::mt19937 generator{ 8601 };
+    auto random = [&generator](int min, int max) { return std::uniform_int_distribution<>{ min, max }(generator); };
+
+    const char* format = basic ? "%04d%02d%02dT%02d%02d%02d%s%s" : "%04d-%02d-%02dT%02d:%02d:%02d%s%s";
+
+    std::vector<std::string> result;
+    for (int i = 0; i < 1000; ++i)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), format, random(1900, 2100), random(1, 12), random(1, 28),
+                      random(0, 23), random(0, 59), random(0, 59), fraction, suffix);
+        result.emplace_back(buffer);
+    }
+    return result;
+}
+
+// shuffled corpus with count strings of each kind
+std::vector<std::string> generate_mixed(std::initializer_list<iso8601_corpus_kind> kinds, std::size_t count)
+{
+    std::vector<std::string> mixed;
+    for (auto kind : kinds)
+    {
+        const auto corpus = generate_iso8601_corpus(kind, count);
+        mixed.insert(mixed.end(), corpus.begin(), corpus.end());
+    }
+    std::shuffle(mixed.begin(), mixed.end(), std::mt19937{ 8601 });
+    return mixed;
+}
+
+template <typename Duration>
+long long parse_all(const std::vector<std::string>& datetimes)
+{
+    long long sum{ 0 };
+    for (const auto& datetime : datetimes)
+        sum += parse_iso8601datetime<Duration>(datetime).time_since_epoch().count();
+    return sum;
+}
+
+// runs body once per iteration, body processes items strings or time points
+template <typename Body>
+void run(benchmark::State& state, std::size_t items, Body body)
+{
+    for (auto _ : state)
+        benchmark::DoNotOptimize(body());
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()) * static_cast<std::int64_t>(items));
+}
+
+// parse_iso8601datetime on the canonical fast path and in the general parser
+
+template <typename Duration>
+void layout(benchmark::State& state, Duration, const char* fraction, const char* suffix, bool basic)
+{
+    const auto datetimes{ generate_datetimes(fraction, suffix, basic) };
+    run(state, datetimes.size(), [&] { return parse_all<Duration>(datetimes); });
+}
+
+BENCHMARK_CAPTURE(layout, canonical, std::chrono::seconds{}, "", "Z", false);
+BENCHMARK_CAPTURE(layout, canonical_fraction, std::chrono::microseconds{}, ".123456", "Z", false);
+BENCHMARK_CAPTURE(layout, general_offset, std::chrono::seconds{}, "", "+01:00", false);
+BENCHMARK_CAPTURE(layout, general_offset_fraction, std::chrono::microseconds{}, ".123456", "+01:00", false);
+BENCHMARK_CAPTURE(layout, general_basic, std::chrono::seconds{}, "", "Z", true);
+
+// parse_iso8601datetimes compared with try_parse_iso8601datetime called for each string
+
+// canonical strings with milliseconds, every tenth one in basic format when mixed
+std::vector<std::string> batch_datetimes(bool mixed)
+{
+    auto       datetimes = generate_datetimes(".123", "Z");
+    const auto basic     = generate_datetimes("", "Z", true);
+    for (std::size_t i = 0; mixed && i < datetimes.size(); i += 10)
+        datetimes[i] = basic[i];
+    return datetimes;
+}
+
+void batch_one_by_one(benchmark::State& state, bool mixed)
+{
+    const auto                                         datetimes{ batch_datetimes(mixed) };
+    const std::vector<std::string_view>                views(datetimes.begin(), datetimes.end());
+    std::vector<time_point<std::chrono::milliseconds>> out(views.size());
+    run(state, views.size(), [&] {
+        for (std::size_t i = 0; i < views.size(); ++i)
+            try_parse_iso8601datetime(views[i], out[i]);
+        return out.back();
+    });
+}
+
+void batch_parse_iso8601datetimes(benchmark::State& state, bool mixed)
+{
+    const auto                                         datetimes{ batch_datetimes(mixed) };
+    const std::vector<std::string_view>                views(datetimes.begin(), datetimes.end());
+    std::vector<time_point<std::chrono::milliseconds>> out(views.size());
+    std::vector<std::uint8_t>                          valid((views.size() + 7) / 8);
+    run(state, views.size(),
+        [&] { return parse_iso8601datetimes(views.data(), views.size(), out.data(), valid.data()); });
+}
+
+BENCHMARK_CAPTURE(batch_one_by_one, canonical, false);
+BENCHMARK_CAPTURE(batch_parse_iso8601datetimes, canonical, false);
+BENCHMARK_CAPTURE(batch_one_by_one, ten_percent_basic, true);
+BENCHMARK_CAPTURE(batch_parse_iso8601datetimes, ten_percent_basic, true);
+
+// parse_iso8601datetimes_parallel on 1M strings, the argument is the number of threads
+
+void parallel(benchmark::State& state)
+{
+    const auto                    datetimes = generate_datetimes(".123", "Z");
+    std::vector<std::string_view> views(1000000);
+    for (std::size_t i = 0; i < views.size(); ++i)
+        views[i] = datetimes[i % datetimes.size()];
+
+    std::vector<time_point<std::chrono::milliseconds>> out(views.size());
+    std::vector<std::uint8_t>                          valid((views.size() + 7) / 8);
+    const auto                                         threads{ static_cast<unsigned int>(state.range(0)) };
+    run(state, views.size(), [&] {
+        return parse_iso8601datetimes_parallel(views.data(), views.size(), out.data(), valid.data(),
+                                               iso8601_required::YYYYMMDDhhmmss, threads);
+    });
+}
+
+// powers of two up to 32 threads and the hardware concurrency; counts above the latter measure
+// oversubscription, not scaling
+void thread_counts(benchmark::internal::Benchmark* benchmark)
+{
+    const unsigned int hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const unsigned int max_threads      = std::max(hardware_threads, 32u);
+    for (unsigned int threads = 1; threads <= max_threads; threads *= 2)
+    {
+        if (threads > hardware_threads && threads / 2 < hardware_threads)
+            benchmark->Arg(hardware_threads);
+        benchmark->Arg(threads);
+    }
+}
+
+BENCHMARK(parallel)->Apply(thread_counts)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// iso8601_sequential_parser on monotonic strings, one to ten seconds apart
+
+std::vector<std::string> monotonic_datetimes()
+{
+    std::vector<std::string> datetimes;
+    int                      seconds{ 0 };
+    for (int i = 0; i < 1000; ++i, seconds += 1 + i % 10)
+    {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "2020-08-13T%02d:%02d:%02d.%03dZ", 10 + seconds / 3600,
+                      seconds / 60 % 60, seconds % 60, i);
+        datetimes.emplace_back(buffer);
+    }
+    return datetimes;
+}
+
+void sequential_parse_iso8601datetime(benchmark::State& state)
+{
+    const auto datetimes{ monotonic_datetimes() };
+    run(state, datetimes.size(), [&] { return parse_all<std::chrono::milliseconds>(datetimes); });
+}
+
+void sequential_iso8601_sequential_parser(benchmark::State& state)
+{
+    const auto datetimes{ monotonic_datetimes() };
+    run(state, datetimes.size(), [&] {
+        iso8601_sequential_parser<std::chrono::milliseconds> parser;
+
+        long long sum{ 0 };
+        for (const auto& datetime : datetimes)
+            sum += parser.parse(datetime).time_since_epoch().count();
+        return sum;
+    });
+}
+
+BENCHMARK(sequential_parse_iso8601datetime);
+BENCHMARK(sequential_iso8601_sequential_parser);
+
+// iso8601_cache on strings repeating 64 distinct values
+
+std::vector<std::string> repeating_datetimes(const char* suffix)
+{
+    const auto               distinct = generate_datetimes(".123", suffix);
+    std::mt19937             generator{ 8601 };
+    std::vector<std::string> datetimes;
+    for (int i = 0; i < 1000; ++i)
+        datetimes.push_back(distinct[std::uniform_int_distribution<>{ 0, 63 }(generator)]);
+    return datetimes;
+}
+
+void cache_parse_iso8601datetime(benchmark::State& state, const char* suffix)
+{
+    const auto datetimes{ repeating_datetimes(suffix) };
+    run(state, datetimes.size(), [&] { return parse_all<std::chrono::milliseconds>(datetimes); });
+}
+
+void cache_iso8601_cache(benchmark::State& state, const char* suffix)
+{
+    const auto                               datetimes{ repeating_datetimes(suffix) };
+    iso8601_cache<std::chrono::milliseconds> cache{ 256 };
+    run(state, datetimes.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& datetime : datetimes)
+            sum += cache.parse(datetime).time_since_epoch().count();
+        return sum;
+    });
+}
+
+BENCHMARK_CAPTURE(cache_parse_iso8601datetime, utc, "Z");
+BENCHMARK_CAPTURE(cache_iso8601_cache, utc, "Z");
+BENCHMARK_CAPTURE(cache_parse_iso8601datetime, offset, "+05:30");
+BENCHMARK_CAPTURE(cache_iso8601_cache, offset, "+05:30");
+
+// parse_iso8601 with a compile-time format compared with parse_iso8601datetime
+
+void format_parse_iso8601datetime(benchmark::State& state, const char* fraction, const char* suffix)
+{
+    const auto datetimes{ generate_datetimes(fraction, suffix) };
+    run(state, datetimes.size(), [&] { return parse_all<std::chrono::milliseconds>(datetimes); });
+}
+
+template <typename Format>
+void format_parse_iso8601(benchmark::State& state, Format, const char* fraction, const char* suffix)
+{
+    const auto datetimes{ generate_datetimes(fraction, suffix) };
+    run(state, datetimes.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& datetime : datetimes)
+            sum += parse_iso8601<Format, std::chrono::milliseconds>(datetime).time_since_epoch().count();
+        return sum;
+    });
+}
+
+BENCHMARK_CAPTURE(format_parse_iso8601datetime, canonical, ".123", "Z");
+BENCHMARK_CAPTURE(format_parse_iso8601, canonical, iso8601_formats::extended_ms_utc{}, ".123", "Z");
+BENCHMARK_CAPTURE(format_parse_iso8601datetime, offset, "", "+05:30");
+BENCHMARK_CAPTURE(format_parse_iso8601, offset, iso8601_formats::extended_offset{}, "", "+05:30");
+
+// general and table-driven engines on strings of mixed layouts
+
+template <typename Engine>
+void engine(benchmark::State& state, Engine parse)
+{
+    const auto mixed{ generate_mixed({ iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic,
+                                       iso8601_corpus_kind::fractional, iso8601_corpus_kind::offset,
+                                       iso8601_corpus_kind::invalid },
+                                     200) };
+    run(state, mixed.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& datetime : mixed)
+        {
+            time_point<std::chrono::microseconds> result{};
+            parse(datetime, result, iso8601_required::YYYYMMDDhhmmss, iso8601_rounding::truncate);
+            sum += result.time_since_epoch().count();
+        }
+        return sum;
+    });
+}
+
+BENCHMARK_CAPTURE(engine, parse_iso8601_general, detail::parse_iso8601_general<std::chrono::microseconds>);
+BENCHMARK_CAPTURE(engine, parse_iso8601_table, detail::parse_iso8601_table<std::chrono::microseconds>);
+
+// is_valid_iso8601 and parse_iso8601fields compared with try_parse_iso8601datetime
+
+std::vector<std::string> validated_datetimes()
+{
+    return generate_mixed({ iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic,
+                            iso8601_corpus_kind::fractional, iso8601_corpus_kind::offset,
+                            iso8601_corpus_kind::invalid },
+                          200);
+}
+
+void validate_try_parse_iso8601datetime(benchmark::State& state)
+{
+    const auto mixed{ validated_datetimes() };
+    run(state, mixed.size(), [&] {
+        int valid{ 0 };
+        for (const auto& datetime : mixed)
+        {
+            time_point<std::chrono::microseconds> result;
+            valid += !try_parse_iso8601datetime(datetime, result);
+        }
+        return valid;
+    });
+}
+
+void validate_is_valid_iso8601(benchmark::State& state)
+{
+    const auto mixed{ validated_datetimes() };
+    run(state, mixed.size(), [&] {
+        int valid{ 0 };
+        for (const auto& datetime : mixed)
+            valid += is_valid_iso8601<std::chrono::microseconds>(datetime);
+        return valid;
+    });
+}
+
+BENCHMARK(validate_try_parse_iso8601datetime);
+BENCHMARK(validate_is_valid_iso8601);
+
+std::vector<std::string> valid_datetimes()
+{
+    return generate_mixed({ iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic,
+                            iso8601_corpus_kind::fractional, iso8601_corpus_kind::offset },
+                          250);
+}
+
+void fields_try_parse_iso8601datetime(benchmark::State& state)
+{
+    const auto mixed{ valid_datetimes() };
+    run(state, mixed.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& datetime : mixed)
+        {
+            time_point<std::chrono::microseconds> result{};
+            try_parse_iso8601datetime(datetime, result);
+            sum += result.time_since_epoch().count();
+        }
+        return sum;
+    });
+}
+
+void fields_try_parse_iso8601fields(benchmark::State& state)
+{
+    const auto mixed{ valid_datetimes() };
+    run(state, mixed.size(), [&] {
+        unsigned int sum{ 0 };
+        for (const auto& datetime : mixed)
+        {
+            iso8601_datetime_fields<std::chrono::microseconds> fields;
+            try_parse_iso8601fields(datetime, fields);
+            sum += fields.month + fields.hours;
+        }
+        return sum;
+    });
+}
+
+BENCHMARK(fields_try_parse_iso8601datetime);
+BENCHMARK(fields_try_parse_iso8601fields);
+
+// hourly histogram of fractional timestamps
+
+void histogram_try_parse_and_floor(benchmark::State& state)
+{
+    const auto                          corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const std::vector<std::string_view> dates(corpus.begin(), corpus.end());
+    const auto origin{ parse_iso8601datetime<std::chrono::microseconds>("1900-01-01T00:00:00Z") };
+    std::vector<std::uint64_t> counts(200 * 366 * 24);
+    run(state, dates.size(), [&] {
+        for (const auto& date : dates)
+        {
+            time_point<std::chrono::microseconds> result;
+            if (!try_parse_iso8601datetime(date, result))
+                ++counts[std::chrono::floor<std::chrono::hours>(result - origin).count()];
+        }
+        return counts[0];
+    });
+}
+
+void histogram_count_iso8601buckets(benchmark::State& state)
+{
+    const auto                          corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const std::vector<std::string_view> dates(corpus.begin(), corpus.end());
+    const iso8601_buckets<std::chrono::microseconds> hours{
+        parse_iso8601datetime<std::chrono::microseconds>("1900-01-01T00:00:00Z"), std::chrono::hours{ 1 }
+    };
+    std::vector<std::uint64_t> counts(200 * 366 * 24);
+    run(state, dates.size(),
+        [&] { return count_iso8601buckets(dates.data(), dates.size(), hours, counts.data(), counts.size()); });
+}
+
+BENCHMARK(histogram_try_parse_and_floor);
+BENCHMARK(histogram_count_iso8601buckets);
+
+// detail::days_from_civil compared with date::sys_days
+
+std::vector<detail::civil_date> random_civil_dates()
+{
+    std::mt19937                    generator{ 8601 };
+    std::vector<detail::civil_date> dates;
+    for (int i = 0; i < 1000; ++i)
+        dates.push_back({ std::uniform_int_distribution<>{ 0, 9999 }(generator),
+                          std::uniform_int_distribution<unsigned int>{ 1, 12 }(generator),
+                          std::uniform_int_distribution<unsigned int>{ 1, 28 }(generator) });
+    return dates;
+}
+
+void calendar_date_sys_days(benchmark::State& state)
+{
+    const auto dates{ random_civil_dates() };
+    run(state, dates.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& civil : dates)
+            sum += date::sys_days{ date::year_month_day{ date::year{ civil.year }, date::month{ civil.month },
+                                                         date::day{ civil.day } } }
+                       .time_since_epoch()
+                       .count();
+        return sum;
+    });
+}
+
+void calendar_days_from_civil(benchmark::State& state)
+{
+    const auto dates{ random_civil_dates() };
+    run(state, dates.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& civil : dates)
+            sum += detail::days_from_civil(civil.year, civil.month, civil.day);
+        return sum;
+    });
+}
+
+BENCHMARK(calendar_date_sys_days);
+BENCHMARK(calendar_days_from_civil);
+
+// strings in Arrow layout cast row by row and with parse_iso8601column
+
+struct arrow_strings
+{
+    std::vector<std::int32_t> offsets{ 0 };
+    std::string               data;
+    std::vector<std::uint8_t> validity;
+    std::size_t               length{ 0 };
+
+    arrow_strings()
+    {
+        const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+        for (const auto& date : corpus)
+        {
+            data += date;
+            offsets.push_back(static_cast<std::int32_t>(data.size()));
+        }
+        length = corpus.size();
+        validity.assign(length / 8, 0xff);
+    }
+};
+
+void column_row_by_row(benchmark::State& state)
+{
+    const arrow_strings       column;
+    std::vector<std::int64_t> out(column.length);
+    std::vector<std::uint8_t> valid(column.length / 8);
+    run(state, column.length, [&] {
+        for (std::size_t i = 0; i < column.length; ++i)
+        {
+            const std::string_view date{ column.data.data() + column.offsets[i],
+                                         static_cast<std::size_t>(column.offsets[i + 1] - column.offsets[i]) };
+            time_point<std::chrono::microseconds> result;
+            const bool present{ ((column.validity[i / 8] >> (i % 8)) & 1) != 0 };
+            const bool parsed{ present && !try_parse_iso8601datetime(date, result) };
+            out[i] = parsed ? result.time_since_epoch().count() : 0;
+            if (parsed)
+                valid[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+            else
+                valid[i / 8] &= static_cast<std::uint8_t>(~(1u << (i % 8)));
+        }
+        return out[0];
+    });
+}
+
+void column_parse_iso8601column(benchmark::State& state)
+{
+    const arrow_strings       column;
+    std::vector<std::int64_t> out(column.length);
+    std::vector<std::uint8_t> valid(column.length / 8);
+    run(state, column.length, [&] {
+        return parse_iso8601column<std::chrono::microseconds>(
+            iso8601_string_column<>{ column.offsets.data(), column.data.data(), column.validity.data(), column.length },
+            out.data(), valid.data());
+    });
+}
+
+BENCHMARK(column_row_by_row);
+BENCHMARK(column_parse_iso8601column);
+
+// timestamps in log lines found with std::regex and for_each_iso8601datetime
+
+constexpr std::size_t log_line_count{ 1000 };
+
+std::string log_lines()
+{
+    std::mt19937 generator{ 8601 };
+    const auto   corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, log_line_count) };
+    std::string  text;
+    for (const auto& date : corpus)
+    {
+        const std::string message{ "INFO [worker-" + std::to_string(generator() % 64) + "] request " +
+                                   std::to_string(generator()) + " from 10.0.0.1 completed in 25 ms, status 200" };
+        const std::size_t split{ generator() % message.size() };
+        text += message.substr(0, split) + " " + date + " " + message.substr(split) + "\n";
+    }
+    return text;
+}
+
+void scan_regex(benchmark::State& state)
+{
+    const std::string text{ log_lines() };
+    const std::regex  pattern{
+        R"(\d{4}-\d{2}-\d{2}T\d{2}[0-9:.,]*(Z|[+-]\d{2}(:\d{2})?)?|\d{8}T\d{2}[0-9.,]*(Z|[+-]\d{2}(:\d{2})?)?)"
+    };
+    run(state, log_line_count, [&] {
+        long long sum{ 0 };
+        for (std::cregex_iterator it{ text.data(), text.data() + text.size(), pattern }, end; it != end; ++it)
+        {
+            const std::string_view match{ text.data() + it->position(), static_cast<std::size_t>(it->length()) };
+            time_point<std::chrono::microseconds> result;
+            if (!try_parse_iso8601datetime(match, result))
+                sum += result.time_since_epoch().count();
+        }
+        return sum;
+    });
+}
+
+void scan_for_each_iso8601datetime(benchmark::State& state)
+{
+    const std::string text{ log_lines() };
+    run(state, log_line_count, [&] {
+        long long sum{ 0 };
+        for_each_iso8601datetime<std::chrono::microseconds>(
+            text, [&sum](const iso8601_match<std::chrono::microseconds>& match) {
+                sum += match.value.time_since_epoch().count();
+            });
+        return sum;
+    });
+}
+
+BENCHMARK(scan_regex);
+BENCHMARK(scan_for_each_iso8601datetime);
+
+// periodic timestamps parsed into an array and into a delta-of-delta column
+
+std::vector<std::string> periodic_datetimes()
+{
+    // one second apart with a jitter of a few milliseconds
+    std::mt19937             generator{ 8601 };
+    std::vector<std::string> datetimes;
+    auto value{ parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T10:00:00Z") };
+    for (int i = 0; i < 100000; ++i)
+    {
+        value += std::chrono::milliseconds{ 1000 + std::uniform_int_distribution<>{ -5, 5 }(generator) };
+        datetimes.push_back(format_iso8601(value, { true, 3 }));
+    }
+    return datetimes;
+}
+
+void delta_vector_of_time_points(benchmark::State& state)
+{
+    const auto datetimes{ periodic_datetimes() };
+    run(state, datetimes.size(), [&] {
+        iso8601_sequential_parser<std::chrono::milliseconds> parser;
+        std::vector<time_point<std::chrono::milliseconds>>   column;
+        for (const auto& datetime : datetimes)
+            column.push_back(parser.parse(datetime));
+        return column.capacity() * sizeof(time_point<std::chrono::milliseconds>);
+    });
+}
+
+void delta_iso8601_delta_encoder(benchmark::State& state)
+{
+    const auto datetimes{ periodic_datetimes() };
+    run(state, datetimes.size(), [&] {
+        iso8601_delta_encoder<std::chrono::milliseconds> encoder;
+        for (const auto& datetime : datetimes)
+            encoder.append(datetime);
+        return encoder.finish().compressed_bytes();
+    });
+}
+
+BENCHMARK(delta_vector_of_time_points)->Unit(benchmark::kMillisecond);
+BENCHMARK(delta_iso8601_delta_encoder)->Unit(benchmark::kMillisecond);
+
+// strings split into two pieces reassembled and parsed incrementally
+
+struct split_strings
+{
+    std::vector<std::string> corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    std::vector<std::pair<std::string_view, std::string_view>> pieces;
+
+    split_strings()
+    {
+        std::mt19937 generator{ 8601 };
+        for (const auto& date : corpus)
+        {
+            const std::size_t split{ generator() % (date.size() + 1) };
+            pieces.emplace_back(std::string_view{ date }.substr(0, split), std::string_view{ date }.substr(split));
+        }
+    }
+};
+
+void incremental_copy_and_parse(benchmark::State& state)
+{
+    const split_strings split;
+    std::string         buffer;
+    run(state, split.pieces.size(), [&] {
+        long long sum{ 0 };
+        for (const auto& [first, second] : split.pieces)
+        {
+            buffer.assign(first);
+            buffer.append(second);
+            time_point<std::chrono::microseconds> result;
+            if (!try_parse_iso8601datetime(buffer, result))
+                sum += result.time_since_epoch().count();
+        }
+        return sum;
+    });
+}
+
+void incremental_iso8601_incremental_parser(benchmark::State& state)
+{
+    const split_strings split;
+    run(state, split.pieces.size(), [&] {
+        iso8601_incremental_parser<std::chrono::microseconds> parser;
+        long long                                             sum{ 0 };
+        for (const auto& [first, second] : split.pieces)
+        {
+            parser.feed(first);
+            parser.feed(second);
+            time_point<std::chrono::microseconds> result;
+            if (!parser.try_finish(result))
+                sum += result.time_since_epoch().count();
+        }
+        return sum;
+    });
+}
+
+BENCHMARK(incremental_copy_and_parse);
+BENCHMARK(incremental_iso8601_incremental_parser);
+
+// strings filtered by a time range starting at 1950; half of them are within 100 years, few
+// within one
+
+void range_try_parse_and_compare(benchmark::State& state, const char* end)
+{
+    const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const auto from{ parse_iso8601datetime<std::chrono::microseconds>("1950-01-01T00:00:00Z") };
+    const auto to{ parse_iso8601datetime<std::chrono::microseconds>(end) };
+    run(state, corpus.size(), [&] {
+        std::size_t count{ 0 };
+        for (const auto& date : corpus)
+        {
+            time_point<std::chrono::microseconds> result;
+            if (!try_parse_iso8601datetime(date, result) && result >= from && result < to)
+                ++count;
+        }
+        return count;
+    });
+}
+
+void range_iso8601_range_filter(benchmark::State& state, const char* end)
+{
+    const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const iso8601_range_filter<std::chrono::microseconds> filter{
+        parse_iso8601datetime<std::chrono::microseconds>("1950-01-01T00:00:00Z"),
+        parse_iso8601datetime<std::chrono::microseconds>(end)
+    };
+    run(state, corpus.size(), [&] { return std::count_if(corpus.begin(), corpus.end(), filter); });
+}
+
+BENCHMARK_CAPTURE(range_try_parse_and_compare, hundred_years, "2050-01-01T00:00:00Z");
+BENCHMARK_CAPTURE(range_iso8601_range_filter, hundred_years, "2050-01-01T00:00:00Z");
+BENCHMARK_CAPTURE(range_try_parse_and_compare, one_year, "1951-01-01T00:00:00Z");
+BENCHMARK_CAPTURE(range_iso8601_range_filter, one_year, "1951-01-01T00:00:00Z");
+
+#if defined(__cpp_lib_ranges)
+// strings before noon counted by a loop and by a views::iso8601_timestamps pipeline
+
+void pipeline_loop(benchmark::State& state)
+{
+    const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const auto noon{ std::chrono::hours{ 12 } };
+    run(state, corpus.size(), [&] {
+        std::size_t count{ 0 };
+        for (const auto& date : corpus)
+        {
+            time_point<std::chrono::milliseconds> result;
+            if (!try_parse_iso8601datetime(date, result) && result.time_since_epoch() % std::chrono::days{ 1 } < noon)
+                ++count;
+        }
+        return count;
+    });
+}
+
+void pipeline_views(benchmark::State& state)
+{
+    const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 1000) };
+    const auto noon{ std::chrono::hours{ 12 } };
+    run(state, corpus.size(), [&] {
+        auto morning = corpus | views::iso8601_timestamps<std::chrono::milliseconds, iso8601_error_policy::skip>() |
+                       std::views::filter([noon](auto value) {
+                           return value.time_since_epoch() % std::chrono::days{ 1 } < noon;
+                       });
+        return std::ranges::distance(morning);
+    });
+}
+
+BENCHMARK(pipeline_loop);
+BENCHMARK(pipeline_views);
+#endif
+
+// format_iso8601 compared with the stream output of the date library
+
+std::vector<time_point<std::chrono::milliseconds>> random_time_points()
+{
+    std::vector<time_point<std::chrono::milliseconds>> time_points;
+    for (const auto& datetime : generate_datetimes(".123", "Z"))
+        time_points.push_back(parse_iso8601datetime<std::chrono::milliseconds>(datetime));
+    return time_points;
+}
+
+void format_ostringstream(benchmark::State& state)
+{
+    const auto time_points{ random_time_points() };
+    run(state, time_points.size(), [&] {
+        std::size_t length{ 0 };
+        for (const auto& tp : time_points)
+        {
+            std::ostringstream stream;
+            date::operator<<(stream, tp);
+            length += stream.str().size();
+        }
+        return length;
+    });
+}
+
+void format_iso8601_string(benchmark::State& state)
+{
+    const auto time_points{ random_time_points() };
+    run(state, time_points.size(), [&] {
+        std::size_t length{ 0 };
+        for (const auto& tp : time_points)
+            length += format_iso8601(tp, { true, 3 }).size();
+        return length;
+    });
+}
+
+void format_iso8601_buffer(benchmark::State& state)
+{
+    const auto time_points{ random_time_points() };
+    run(state, time_points.size(), [&] {
+        char        buffer[iso8601_max_length];
+        std::size_t length{ 0 };
+        for (const auto& tp : time_points)
+            length += format_iso8601(tp, buffer, { true, 3 });
+        return length;
+    });
+}
+
+BENCHMARK(format_ostringstream);
+BENCHMARK(format_iso8601_string);
+BENCHMARK(format_iso8601_buffer);
+
+// format_iso8601datetimes on time points within a few days, one millisecond to ten seconds apart
+
+std::vector<time_point<std::chrono::milliseconds>> close_time_points()
+{
+    std::mt19937                                       generator{ 8601 };
+    std::vector<time_point<std::chrono::milliseconds>> time_points;
+    auto tp{ parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T00:00:00Z") };
+    for (int i = 0; i < 100000; ++i)
+    {
+        tp += std::chrono::milliseconds{ std::uniform_int_distribution<>{ 1, 10000 }(generator) };
+        time_points.push_back(tp);
+    }
+    return time_points;
+}
+
+void format_batch_one_by_one(benchmark::State& state)
+{
+    const auto               time_points{ close_time_points() };
+    std::vector<char>        out(time_points.size() * iso8601_max_length);
+    std::vector<std::size_t> offsets(time_points.size() + 1);
+    run(state, time_points.size(), [&] {
+        std::size_t offset{ 0 };
+        for (std::size_t i = 0; i < time_points.size(); ++i)
+        {
+            offsets[i] = offset;
+            offset += format_iso8601(time_points[i], out.data() + offset, { true, 3 });
+        }
+        return offset;
+    });
+}
+
+void format_batch_format_iso8601datetimes(benchmark::State& state)
+{
+    const auto               time_points{ close_time_points() };
+    std::vector<char>        out(time_points.size() * iso8601_max_length);
+    std::vector<std::size_t> offsets(time_points.size() + 1);
+    run(state, time_points.size(), [&] {
+        return format_iso8601datetimes(time_points.data(), time_points.size(), out.data(), offsets.data(),
+                                       { true, 3 });
+    });
+}
+
+BENCHMARK(format_batch_one_by_one)->Unit(benchmark::kMillisecond);
+BENCHMARK(format_batch_format_iso8601datetimes)->Unit(benchmark::kMillisecond);
+
+} // namespace
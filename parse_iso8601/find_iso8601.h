@@ -0,0 +1,221 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ISO8601_FIND_SSE2
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace core::time {
+
+// Timestamp found in text: text.substr(offset, length) parses to value.
+template <typename Duration = std::chrono::seconds>
+struct iso8601_match
+{
+    std::size_t          offset;
+    std::size_t          length;
+    time_point<Duration> value;
+};
+
+namespace detail {
+
+// Candidates are located by their anchor byte, the '-' after the year of 'YYYY-MM-DD' or the 'T'
+// after the date of 'YYYYMMDDThh'; text is classified in blocks of this many bytes.
+constexpr std::size_t anchor_block_size{ 16 };
+
+// bit i is set if block[i] is '-' or 'T'
+inline unsigned int anchor_mask(const char* block) noexcept
+{
+#if defined(ISO8601_FIND_SSE2)
+    const __m128i bytes{ _mm_loadu_si128(reinterpret_cast<const __m128i*>(block)) };
+    const __m128i anchors{ _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('-')),
+                                        _mm_cmpeq_epi8(bytes, _mm_set1_epi8('T'))) };
+    return static_cast<unsigned int>(_mm_movemask_epi8(anchors));
+#else
+    // high bit of each byte equal to the corresponding one of broadcast; bytes are compared
+    // without carries between them, so there are no false positives
+    auto equal_bytes = [](std::uint64_t chunk, std::uint64_t broadcast) {
+        constexpr std::uint64_t low_bits{ 0x7f7f7f7f7f7f7f7f };
+        const std::uint64_t     differences{ chunk ^ broadcast };
+        return ~(((differences & low_bits) + low_bits) | differences | low_bits);
+    };
+    // moves the high bit of byte i to bit i
+    auto gather = [](std::uint64_t high_bits) {
+        return static_cast<unsigned int>(((high_bits >> 7) * 0x0102040810204080) >> 56);
+    };
+
+    unsigned int mask{ 0 };
+    for (int half = 0; half < 2; ++half)
+    {
+        const std::uint64_t chunk{ load_le64(block + 8 * half) };
+        mask |= gather(equal_bytes(chunk, 0x2d2d2d2d2d2d2d2d) | equal_bytes(chunk, 0x5454545454545454))
+                << (8 * half);
+    }
+    return mask;
+#endif
+}
+
+// index of the least significant bit set, mask must not be 0
+inline unsigned int lowest_bit_index(unsigned int mask) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif
+}
+
+// Extent [begin, end) of the timestamp shape around anchor: 'YYYY-MM-DD' or 'YYYYMMDDThh'
+// followed by the longest run of time components, fractions and offset the grammar allows in the
+// same format. Fails if the shape is preceded or followed by a digit, so that it is not cut out
+// of a longer number. Whether the components are valid is left to the parser.
+inline bool match_iso8601_shape(std::string_view text, std::size_t anchor, std::size_t& begin,
+                                std::size_t& end) noexcept
+{
+    auto is_digit = [&text](std::size_t position) {
+        return position < text.size() && static_cast<unsigned int>(text[position] - '0') < 10;
+    };
+    auto digits = [&is_digit](std::size_t position, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+            if (!is_digit(position + i))
+                return false;
+        return true;
+    };
+    auto is_char = [&text](std::size_t position, char ch) {
+        return position < text.size() && text[position] == ch;
+    };
+
+    const bool extended{ text[anchor] == '-' };
+    if (extended)
+    {
+        if (anchor < 4 || !digits(anchor - 4, 4) || !digits(anchor + 1, 2) ||
+            !is_char(anchor + 3, '-') || !digits(anchor + 4, 2))
+            return false;
+        begin = anchor - 4;
+        end   = anchor + 6;
+    }
+    else
+    {
+        if (anchor < 8 || !digits(anchor - 8, 8) || !digits(anchor + 1, 2))
+            return false;
+        begin = anchor - 8;
+        end   = anchor + 3;
+    }
+    if (begin > 0 && is_digit(begin - 1))
+        return false;
+
+    if (extended)
+    {
+        if (!is_char(end, 'T') || !digits(end + 1, 2))
+            return !is_digit(end);
+        end += 3;
+    }
+
+    auto fraction = [&]() {
+        if ((is_char(end, '.') || is_char(end, ',')) && is_digit(end + 1))
+            for (end += 2; is_digit(end); ++end)
+                ;
+    };
+    // hours have been matched, minutes and seconds may follow
+    fraction();
+    const std::size_t separator{ extended ? 1u : 0u };
+    for (int i = 0; i < 2 && (!extended || is_char(end, ':')) && digits(end + separator, 2); ++i)
+    {
+        end += separator + 2;
+        fraction();
+    }
+
+    if (is_char(end, 'Z'))
+        ++end;
+    else
+    {
+        std::size_t sign{ 0 };
+        if (is_char(end, '+') || is_char(end, '-'))
+            sign = 1;
+        // utf-8 minus sign
+        else if (text.substr(end, 3) == "\xe2\x88\x92")
+            sign = 3;
+        if (sign != 0 && digits(end + sign, 2))
+        {
+            end += sign + 2;
+            if (is_char(end, ':') && digits(end + 1, 2))
+                end += 3;
+        }
+    }
+    return !is_digit(end);
+}
+
+} // namespace detail
+
+// Finds the first timestamp in text starting at or after position, e.g. in a log line. Candidates
+// of 'YYYY-MM-DD...' and 'YYYYMMDDThh...' shapes not adjacent to other digits are located with a
+// vectorized byte scan and parsed with try_parse_iso8601datetime; candidates that do not parse or
+// lack required components are skipped. Returns false if there is no such timestamp.
+template <typename Duration = std::chrono::seconds>
+inline bool find_iso8601datetime(std::string_view text, iso8601_match<Duration>& match,
+                                 std::size_t      position = 0,
+                                 iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    using detail::anchor_block_size;
+
+    // anchors are at least 4 characters after the beginning of a timestamp
+    for (std::size_t block = position + 4; block < text.size(); block += anchor_block_size)
+    {
+        unsigned int mask;
+        if (text.size() - block >= anchor_block_size)
+            mask = detail::anchor_mask(text.data() + block);
+        else
+        {
+            char last[anchor_block_size]{};
+            std::memcpy(last, text.data() + block, text.size() - block);
+            mask = detail::anchor_mask(last);
+        }
+
+        for (; mask != 0; mask &= mask - 1)
+        {
+            const std::size_t anchor{ block + detail::lowest_bit_index(mask) };
+            std::size_t       begin;
+            std::size_t       end;
+            if (!detail::match_iso8601_shape(text, anchor, begin, end) || begin < position)
+                continue;
+            time_point<Duration> value;
+            if (try_parse_iso8601datetime(text.substr(begin, end - begin), value, required))
+                continue;
+            match = { begin, end - begin, value };
+            return true;
+        }
+    }
+    return false;
+}
+
+// Calls callback(match) for each timestamp in text, in order of offsets, as found by
+// find_iso8601datetime. Returns the number of timestamps found.
+template <typename Duration = std::chrono::seconds, typename Callback>
+inline std::size_t
+for_each_iso8601datetime(std::string_view text, Callback callback,
+                         iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+{
+    std::size_t             count{ 0 };
+    iso8601_match<Duration> match;
+    for (std::size_t position = 0; find_iso8601datetime(text, match, position, required);
+         position             = match.offset + match.length)
+    {
+        callback(match);
+        ++count;
+    }
+    return count;
+}
+
+} // namespace core::time
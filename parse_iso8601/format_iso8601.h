@@ -0,0 +1,255 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ratio>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace core::time {
+
+// time zone designator written after the time
+enum class iso8601_zone
+{
+    // local time without designator
+    none,
+    // 'Z'
+    utc,
+    // '+hh:mm' or '-hh:mm', also in basic form as the parser expects the separator
+    offset,
+};
+
+struct iso8601_format_options
+{
+    // 'YYYY-MM-DDThh:mm:ss' if true, 'YYYYMMDDThhmmss' otherwise
+    bool extended{ true };
+    // number of fraction digits, 0 to 9; digits beyond Duration resolution are zeros
+    unsigned int precision{ 0 };
+    iso8601_zone zone{ iso8601_zone::utc };
+    // for iso8601_zone::offset, time is written as UTC shifted by offset_minutes; only offsets
+    // accepted by the parser can be written
+    int offset_minutes{ 0 };
+};
+
+// longest output: 'YYYY-MM-DDThh:mm:ss.fffffffff+hh:mm'
+constexpr std::size_t iso8601_max_length{ 35 };
+
+namespace detail {
+
+struct digit_pairs
+{
+    char data[200];
+
+    constexpr digit_pairs()
+        : data{}
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            data[2 * i]     = static_cast<char>('0' + i / 10);
+            data[2 * i + 1] = static_cast<char>('0' + i % 10);
+        }
+    }
+};
+
+inline constexpr digit_pairs two_digits{};
+
+inline char* write_two_digits(char* out, unsigned int value) noexcept
+{
+    std::memcpy(out, two_digits.data + 2 * value, 2);
+    return out + 2;
+}
+
+// stores 8 characters, the least significant byte first
+inline void store_le64(char* p, std::uint64_t value) noexcept
+{
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    std::memcpy(p, &value, sizeof(value));
+#else
+    for (int i = 0; i < 8; ++i)
+        p[i] = static_cast<char>(value >> (8 * i));
+#endif
+}
+
+// days since epoch of 0000-01-01 and 9999-12-31, the range of years written without expansion
+constexpr long long first_formatted_day{ days_from_civil(0, 1, 1) };
+constexpr long long last_formatted_day{ days_from_civil(9999, 12, 31) };
+
+constexpr bool is_formatted_day(long long day) noexcept
+{
+    return day >= first_formatted_day && day <= last_formatted_day;
+}
+
+// false for offsets rejected by the parser, so that all output can be parsed back
+constexpr bool is_formatted_zone(const iso8601_format_options& options) noexcept
+{
+    if (options.zone != iso8601_zone::offset)
+        return true;
+    if (options.offset_minutes <= -24 * 60 || options.offset_minutes >= 24 * 60)
+        return false;
+
+    const bool         positive{ options.offset_minutes >= 0 };
+    const unsigned int minutes{ static_cast<unsigned int>(positive ? options.offset_minutes
+                                                                   : -options.offset_minutes) };
+    return timezone_offset{ positive, minutes / 60, minutes % 60 }.ok();
+}
+
+// time point shifted by the offset of the format options, split into day and time of day
+template <typename Duration>
+struct local_time
+{
+    // days since epoch
+    long long day;
+    // at least as fine as minutes, so that the offset can be applied to any Duration
+    std::common_type_t<Duration, std::chrono::minutes> time_of_day;
+};
+
+// Converts tp into local time. Returns false if the day is outside 0000-9999; days are counted
+// in long long and checked before the offset is applied, so far time points neither wrap nor
+// overflow.
+template <typename Duration>
+constexpr bool to_local_time(time_point<Duration> tp, const iso8601_format_options& options,
+                             local_time<Duration>& result) noexcept
+{
+    using day_duration   = std::chrono::duration<long long, std::ratio<86400>>;
+    using local_duration = std::common_type_t<Duration, std::chrono::minutes>;
+
+    // an offset moves the time point by less than a day
+    const long long utc_day{ std::chrono::floor<day_duration>(tp.time_since_epoch()).count() };
+    if (utc_day < first_formatted_day - 1 || utc_day > last_formatted_day + 1)
+        return false;
+
+    local_duration local{ tp.time_since_epoch() };
+    if (options.zone == iso8601_zone::offset)
+        local += std::chrono::minutes{ options.offset_minutes };
+    const auto day{ std::chrono::floor<day_duration>(local) };
+    if (!is_formatted_day(day.count()))
+        return false;
+
+    result = { day.count(), local - day };
+    return true;
+}
+
+// writes 'YYYY-MM-DDT' or 'YYYYMMDDT', year must be in 0000-9999 range
+inline char* write_date(char* p, const civil_date& date, bool extended) noexcept
+{
+    const auto year_number{ static_cast<unsigned int>(date.year) };
+    p = write_two_digits(p, year_number / 100);
+    p = write_two_digits(p, year_number % 100);
+    if (extended)
+        *p++ = '-';
+    p = write_two_digits(p, date.month);
+    if (extended)
+        *p++ = '-';
+    p    = write_two_digits(p, date.day);
+    *p++ = 'T';
+    return p;
+}
+
+// Writes 'hh:mm:ss' or 'hhmmss' with a single 8-byte store (out must have room for 8 characters).
+// Hours, minutes and seconds are placed into separate lanes and all tens are obtained at once by
+// multiplying with 103 / 1024, which is exact for numbers below 100.
+inline char* write_time_of_day(char* p, unsigned int seconds, bool extended) noexcept
+{
+    const int           lane{ extended ? 24 : 16 };
+    const std::uint64_t values{ std::uint64_t{ seconds / 3600 } |
+                                std::uint64_t{ seconds / 60 % 60 } << lane |
+                                std::uint64_t{ seconds % 60 } << (2 * lane) };
+    const std::uint64_t tens_mask{ 0xf | std::uint64_t{ 0xf } << lane |
+                                   std::uint64_t{ 0xf } << (2 * lane) };
+    const std::uint64_t tens{ (values * 103 >> 10) & tens_mask };
+    const std::uint64_t digits{ tens | (values - tens * 10) << 8 };
+    store_le64(p, digits | (extended ? 0x30303a30303a3030 : 0x0000303030303030));
+    return p + (extended ? 8 : 6);
+}
+
+// writes '.' followed by precision (1 to 9) leading digits of nanoseconds
+inline char* write_fraction(char* p, unsigned long nanoseconds, unsigned int precision) noexcept
+{
+    for (unsigned int i = precision; i < 9; ++i)
+        nanoseconds /= 10;
+    *p++ = '.';
+    for (unsigned int i = precision; i > 0; --i, nanoseconds /= 10)
+        p[i - 1] = static_cast<char>('0' + nanoseconds % 10);
+    return p + precision;
+}
+
+inline char* write_zone(char* p, const iso8601_format_options& options) noexcept
+{
+    switch (options.zone)
+    {
+    case iso8601_zone::none:
+        break;
+    case iso8601_zone::utc:
+        *p++ = 'Z';
+        break;
+    case iso8601_zone::offset:
+    {
+        const unsigned int offset{ static_cast<unsigned int>(
+            options.offset_minutes < 0 ? -options.offset_minutes : options.offset_minutes) };
+        *p++ = options.offset_minutes < 0 ? '-' : '+';
+        p    = write_two_digits(p, offset / 60);
+        *p++ = ':';
+        p    = write_two_digits(p, offset % 60);
+        break;
+    }
+    }
+    return p;
+}
+
+// writes time of day, fraction and zone designator following the date
+template <typename Duration>
+inline char* write_time(char* p, Duration time_of_day, const iso8601_format_options& options) noexcept
+{
+    using std::chrono::floor;
+    using std::chrono::seconds;
+
+    const auto whole_seconds{ floor<seconds>(time_of_day) };
+    p = write_time_of_day(p, static_cast<unsigned int>(whole_seconds.count()), options.extended);
+    if (options.precision > 0)
+        p = write_fraction(
+            p,
+            static_cast<unsigned long>(
+                floor<std::chrono::nanoseconds>(time_of_day - whole_seconds).count()),
+            options.precision < 9 ? options.precision : 9);
+    return write_zone(p, options);
+}
+
+} // namespace detail
+
+// Writes time point into out, which must hold at least iso8601_max_length characters. No
+// terminating null character is written. Returns the number of characters written or 0 if the
+// year is outside 0000-9999, which ISO 8601 cannot represent without expansion, or if the offset
+// would be rejected by the parser. Any other output is parsed back by parse_iso8601datetime to
+// the same time point, truncated to precision.
+template <typename Duration>
+inline std::size_t format_iso8601(time_point<Duration> tp, char* out,
+                                  const iso8601_format_options& options = {}) noexcept
+{
+    detail::local_time<Duration> local{};
+    if (!detail::is_formatted_zone(options) || !detail::to_local_time(tp, options, local))
+        return 0;
+
+    char* p{ detail::write_date(out, detail::civil_from_days(local.day), options.extended) };
+    p = detail::write_time(p, local.time_of_day, options);
+    return static_cast<std::size_t>(p - out);
+}
+
+template <typename Duration>
+inline std::string format_iso8601(time_point<Duration>         tp,
+                                  const iso8601_format_options& options = {})
+{
+    char              buffer[iso8601_max_length];
+    const std::size_t length{ format_iso8601(tp, buffer, options) };
+    if (length == 0)
+        throw std::out_of_range(detail::is_formatted_zone(options)
+                                    ? "Year outside of 0000-9999 range"
+                                    : "Timezone offset not accepted by the parser");
+    return std::string(buffer, length);
+}
+
+} // namespace core::time
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "format_iso8601.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace core::time {
+
+// Formats count time points one after another into out, which must hold
+// count * iso8601_max_length characters. offsets must hold count + 1 entries: string i is stored
+// at [offsets[i], offsets[i + 1]), time points with years outside 0000-9999 are stored as empty
+// strings, all of them if the offset would be rejected by the parser. Returns the number of
+// formatted time points.
+// The date part is converted only when the day changes and copied otherwise, so columns of
+// time points that mostly fall on the same day are formatted at the cost of time of day only.
+template <typename Duration>
+inline std::size_t format_iso8601datetimes(const time_point<Duration>* tps, std::size_t count,
+                                           char* out, std::size_t* offsets,
+                                           const iso8601_format_options& options = {}) noexcept
+{
+    // 'YYYY-MM-DDT' of the last day
+    char        prefix[11];
+    std::size_t prefix_length{ 0 };
+    long long   prefix_day{ std::numeric_limits<long long>::max() };
+
+    const bool  formatted_zone{ detail::is_formatted_zone(options) };
+    std::size_t formatted{ 0 };
+    std::size_t offset{ 0 };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        offsets[i] = offset;
+        detail::local_time<Duration> local{};
+        if (!formatted_zone || !detail::to_local_time(tps[i], options, local))
+            continue;
+
+        if (local.day != prefix_day)
+        {
+            prefix_day    = local.day;
+            prefix_length = static_cast<std::size_t>(
+                detail::write_date(prefix, detail::civil_from_days(local.day), options.extended) -
+                prefix);
+        }
+
+        char* p{ out + offset };
+        std::memcpy(p, prefix, prefix_length);
+        p = detail::write_time(p + prefix_length, local.time_of_day, options);
+        offset = static_cast<std::size_t>(p - out);
+        ++formatted;
+    }
+    offsets[count] = offset;
+    return formatted;
+}
+
+#if defined(__cpp_lib_span)
+template <typename Duration>
+inline std::size_t format_iso8601datetimes(std::span<const time_point<Duration>> tps,
+                                           std::span<char> out, std::span<std::size_t> offsets,
+                                           const iso8601_format_options& options = {}) noexcept
+{
+    assert(out.size() >= tps.size() * iso8601_max_length);
+    assert(offsets.size() >= tps.size() + 1);
+    return format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), options);
+}
+#endif
+
+} // namespace core::time
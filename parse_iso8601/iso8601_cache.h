@@ -0,0 +1,132 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace core::time {
+
+// Bounded cache of parsed date and time strings for workloads in which the same strings repeat
+// in random order. Open-addressing table with a short linear probe; when all probed slots are
+// taken, the first one is overwritten. Only successfully parsed strings are cached, strings
+// longer than max_key_length bypass the cache.
+// The cache is not synchronised: use a separate instance per thread, e.g. a thread_local one.
+template <typename Duration = std::chrono::seconds>
+class iso8601_cache
+{
+public:
+    static constexpr std::size_t max_key_length{ 40 };
+
+    // capacity is rounded up to a power of two
+    explicit iso8601_cache(std::size_t capacity = 4096,
+                           iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+        : required_(required)
+    {
+        while (capacity_ < capacity)
+            capacity_ *= 2;
+        entries_ = std::make_unique<entry[]>(capacity_);
+    }
+
+    iso8601_error try_parse(std::string_view date, time_point<Duration>& result) noexcept
+    {
+        if (date.empty() || date.size() > max_key_length)
+        {
+            ++misses_;
+            return try_parse_iso8601datetime(date, result, required_);
+        }
+
+        const std::size_t home{ hash(date) & (capacity_ - 1) };
+        for (std::size_t i = 0; i < probe_length; ++i)
+        {
+            const entry& candidate = entries_[(home + i) & (capacity_ - 1)];
+            if (candidate.length == 0)
+                break;
+            if (candidate.length == date.size() &&
+                std::memcmp(candidate.key, date.data(), date.size()) == 0)
+            {
+                ++hits_;
+                result = candidate.value;
+                return {};
+            }
+        }
+
+        ++misses_;
+        if (auto error = try_parse_iso8601datetime(date, result, required_))
+            return error;
+
+        entry* slot{ &entries_[home] };
+        for (std::size_t i = 0; i < probe_length; ++i)
+        {
+            entry& candidate = entries_[(home + i) & (capacity_ - 1)];
+            if (candidate.length == 0)
+            {
+                slot = &candidate;
+                break;
+            }
+        }
+        std::memcpy(slot->key, date.data(), date.size());
+        slot->length = static_cast<std::uint8_t>(date.size());
+        slot->value  = result;
+        return {};
+    }
+
+    time_point<Duration> parse(std::string_view date)
+    {
+        time_point<Duration> result;
+        if (auto error = try_parse(date, result))
+            throw iso8601_parse_error(error);
+        return result;
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t hits() const noexcept { return hits_; }
+    std::size_t misses() const noexcept { return misses_; }
+
+    // removes all entries and resets counters
+    void clear() noexcept
+    {
+        for (std::size_t i = 0; i < capacity_; ++i)
+            entries_[i].length = 0;
+        hits_   = 0;
+        misses_ = 0;
+    }
+
+private:
+    static constexpr std::size_t probe_length{ 4 };
+
+    struct entry
+    {
+        time_point<Duration> value;
+        std::uint8_t         length{ 0 };
+        char                 key[max_key_length];
+    };
+
+    // multiplicative hashing of 8-byte words
+    static std::size_t hash(std::string_view key) noexcept
+    {
+        std::uint64_t result{ key.size() };
+        std::size_t   i{ 0 };
+        for (; i + 8 <= key.size(); i += 8)
+            result = (result ^ detail::load_le64(key.data() + i)) * 0x9e3779b97f4a7c15;
+        if (i < key.size())
+        {
+            std::uint64_t last{ 0 };
+            std::memcpy(&last, key.data() + i, key.size() - i);
+            result = (result ^ last) * 0x9e3779b97f4a7c15;
+        }
+        return static_cast<std::size_t>(result ^ (result >> 29));
+    }
+
+    iso8601_required         required_;
+    std::size_t              capacity_{ probe_length };
+    std::unique_ptr<entry[]> entries_;
+    std::size_t              hits_{ 0 };
+    std::size_t              misses_{ 0 };
+};
+
+} // namespace core::time
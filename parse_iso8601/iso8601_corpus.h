@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace core::time {
+
+// layout of generated timestamps
+enum class iso8601_corpus_kind
+{
+    // 'YYYY-MM-DDThh:mm:ssZ'
+    canonical,
+    // 'YYYYMMDDThhmmssZ'
+    basic,
+    // 'YYYY-MM-DDThh:mm:ss.ffffffZ'
+    fractional,
+    // 'YYYY-MM-DDThh:mm:ss±hh:mm'
+    offset,
+    // canonical strings with a single defect each
+    invalid,
+};
+
+// Generates count random timestamps of given kind. The same seed always yields the same corpus, so
+// benchmark results of different builds are comparable. Years are in 1900-2099, days up to 28 so
+// that all valid strings are valid dates for any parser.
+inline std::vector<std::string> generate_iso8601_corpus(iso8601_corpus_kind kind, std::size_t count,
+                                                        std::uint32_t seed = 8601)
+{
+    std::mt19937 generator{ seed };
+    auto         random = [&generator](int min, int max) {
+        return std::uniform_int_distribution<>{ min, max }(generator);
+    };
+
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const int year{ random(1900, 2099) };
+        const int month{ random(1, 12) };
+        const int day{ random(1, 28) };
+        const int hours{ random(0, 23) };
+        const int minutes{ random(0, 59) };
+        const int seconds{ random(0, 59) };
+
+        char buffer[64];
+        switch (kind)
+        {
+        case iso8601_corpus_kind::canonical:
+        case iso8601_corpus_kind::invalid:
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02dZ", year, month, day,
+                          hours, minutes, seconds);
+            break;
+        case iso8601_corpus_kind::basic:
+            std::snprintf(buffer, sizeof(buffer), "%04d%02d%02dT%02d%02d%02dZ", year, month, day,
+                          hours, minutes, seconds);
+            break;
+        case iso8601_corpus_kind::fractional:
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%06dZ", year, month,
+                          day, hours, minutes, seconds, random(0, 999999));
+            break;
+        case iso8601_corpus_kind::offset:
+        {
+            // offsets in use, as accepted by the parser
+            static const char* const offsets[]{ "+00:00", "+01:00", "+02:00", "+03:00", "+05:30",
+                                                "+05:45", "+08:00", "+09:00", "+09:30", "+12:45",
+                                                "+14:00", "-03:00", "-03:30", "-05:00", "-08:00",
+                                                "-09:30", "-12:00" };
+            const int offset{ random(0, static_cast<int>(std::size(offsets)) - 1) };
+            std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d%s", year, month,
+                          day, hours, minutes, seconds, offsets[offset]);
+            break;
+        }
+        }
+        std::string date{ buffer };
+
+        if (kind == iso8601_corpus_kind::invalid)
+        {
+            switch (random(0, 5))
+            {
+            case 0:
+                // letter instead of a digit
+                date[static_cast<std::size_t>(random(0, 3))] = 'x';
+                break;
+            case 1:
+                // truncated inside seconds
+                date.resize(18);
+                break;
+            case 2:
+                // month out of range
+                date.replace(5, 2, "13");
+                break;
+            case 3:
+                // day out of range
+                date.replace(8, 2, "32");
+                break;
+            case 4:
+                // minutes out of range
+                date.replace(14, 2, "60");
+                break;
+            case 5:
+                // wrong separator
+                date[13] = '-';
+                break;
+            }
+        }
+        result.push_back(std::move(date));
+    }
+    return result;
+}
+
+} // namespace core::time
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "iso8601_sequential_parser.h"
+#include "parse_iso8601.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace core::time {
+
+// Number of timestamps per independently decodable block
+constexpr std::size_t iso8601_delta_block_size{ 1024 };
+
+namespace detail {
+
+// Classes of delta-of-delta values as in Gorilla: a prefix of ones terminated by a zero (except
+// for the last class) followed by the zigzag encoded value. Bits are stored from the least
+// significant bit of each word up, so prefixes are written in reverse.
+struct delta_class
+{
+    unsigned int  prefix_bits;
+    std::uint64_t prefix;
+    unsigned int  value_bits;
+};
+
+constexpr delta_class delta_classes[]{ { 1, 0b0, 0 },      { 2, 0b01, 7 },     { 3, 0b011, 9 },
+                                       { 4, 0b0111, 12 },  { 5, 0b01111, 32 }, { 5, 0b11111, 64 } };
+constexpr unsigned int delta_prefix_bits{ 5 };
+
+// maps signed values of small magnitude to small unsigned ones: 0, -1, 1, -2, ... to 0, 1, 2, 3
+constexpr std::uint64_t zigzag_encode(std::uint64_t value) noexcept
+{
+    return (value << 1) ^ (0 - (value >> 63));
+}
+
+constexpr std::uint64_t zigzag_decode(std::uint64_t value) noexcept
+{
+    return (value >> 1) ^ (0 - (value & 1));
+}
+
+// appends count bits of value, which has no other bits set, at bit position of words
+inline void append_bits(std::vector<std::uint64_t>& words, std::size_t& position,
+                        std::uint64_t value, unsigned int count)
+{
+    assert(count > 0 && count <= 64);
+    const unsigned int shift{ static_cast<unsigned int>(position % 64) };
+    if (shift == 0)
+        words.push_back(value);
+    else
+    {
+        words.back() |= value << shift;
+        if (shift + count > 64)
+            words.push_back(value >> (64 - shift));
+    }
+    position += count;
+}
+
+// reads count bits at bit position; bits past the end of words read as zeros
+inline std::uint64_t read_bits(const std::vector<std::uint64_t>& words, std::size_t position,
+                               unsigned int count) noexcept
+{
+    assert(count > 0 && count <= 64);
+    const std::size_t  index{ position / 64 };
+    const unsigned int shift{ static_cast<unsigned int>(position % 64) };
+    std::uint64_t      value{ words[index] >> shift };
+    if (shift + count > 64 && index + 1 < words.size())
+        value |= words[index + 1] << (64 - shift);
+    return count == 64 ? value : value & ((std::uint64_t{ 1 } << count) - 1);
+}
+
+} // namespace detail
+
+template <typename Duration>
+class iso8601_delta_encoder;
+
+// Timestamps compressed with delta-of-delta encoding, as produced by iso8601_delta_encoder. Blocks
+// of block_size() timestamps start with an uncompressed value and are decoded independently, so
+// any block can be accessed without decoding the preceding ones. Sorted columns with regular
+// intervals take a few bits per timestamp; any sequence is supported.
+template <typename Duration = std::chrono::milliseconds>
+class iso8601_delta_column
+{
+public:
+    static_assert(std::is_integral_v<typename Duration::rep> &&
+                      sizeof(typename Duration::rep) == sizeof(std::uint64_t),
+                  "ticks must be 64-bit integers");
+
+    std::size_t size() const noexcept { return size_; }
+
+    std::size_t block_size() const noexcept { return block_size_; }
+
+    std::size_t block_count() const noexcept { return blocks_.size(); }
+
+    // memory taken by the encoded data and block index
+    std::size_t compressed_bytes() const noexcept
+    {
+        return words_.size() * sizeof(std::uint64_t) + blocks_.size() * sizeof(block_entry);
+    }
+
+    // Decodes the timestamps of block into out, which must hold block_size() values. Returns the
+    // number of timestamps decoded, less than block_size() only for the last block.
+    std::size_t decode_block(std::size_t block, time_point<Duration>* out) const noexcept
+    {
+        const std::size_t count{ block_length(block) };
+        for_each_value(block, count,
+                       [out](std::size_t i, time_point<Duration> value) { out[i] = value; });
+        return count;
+    }
+
+    // Decodes all timestamps into out, which must hold size() values.
+    void decode(time_point<Duration>* out) const noexcept
+    {
+        for (std::size_t block = 0; block < blocks_.size(); ++block)
+            out += decode_block(block, out);
+    }
+
+    // Timestamp at index, decoding its block up to it.
+    time_point<Duration> operator[](std::size_t index) const noexcept
+    {
+        assert(index < size_);
+        time_point<Duration> result;
+        for_each_value(index / block_size_, index % block_size_ + 1,
+                       [&result](std::size_t, time_point<Duration> value) { result = value; });
+        return result;
+    }
+
+private:
+    friend class iso8601_delta_encoder<Duration>;
+
+    struct block_entry
+    {
+        std::uint64_t first;
+        std::size_t   position;
+    };
+
+    explicit iso8601_delta_column(std::size_t block_size) noexcept
+        : block_size_(block_size)
+    {
+    }
+
+    std::size_t block_length(std::size_t block) const noexcept
+    {
+        assert(block < blocks_.size());
+        return block + 1 < blocks_.size() ? block_size_ : size_ - block * block_size_;
+    }
+
+    // decodes the first count values of block, passing each one to store(index, value)
+    template <typename Store>
+    void for_each_value(std::size_t block, std::size_t count, Store store) const noexcept
+    {
+        auto to_time_point = [](std::uint64_t ticks) {
+            return time_point<Duration>{ Duration{ static_cast<typename Duration::rep>(ticks) } };
+        };
+
+        std::uint64_t value{ blocks_[block].first };
+        std::uint64_t delta{ 0 };
+        std::size_t   position{ blocks_[block].position };
+        store(0, to_time_point(value));
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            const std::uint64_t prefix{ detail::read_bits(words_, position,
+                                                          detail::delta_prefix_bits) };
+            std::size_t         index{ 0 };
+            while (index < detail::delta_prefix_bits && ((prefix >> index) & 1))
+                ++index;
+            const detail::delta_class& kind{ detail::delta_classes[index] };
+            position += kind.prefix_bits;
+            if (kind.value_bits != 0)
+            {
+                delta += detail::zigzag_decode(detail::read_bits(words_, position, kind.value_bits));
+                position += kind.value_bits;
+            }
+            value += delta;
+            store(i, to_time_point(value));
+        }
+    }
+
+    std::size_t                block_size_;
+    std::size_t                size_{ 0 };
+    std::vector<std::uint64_t> words_;
+    std::vector<block_entry>   blocks_;
+};
+
+// Streaming stage between the parser and a compressed column: each timestamp is parsed with an
+// iso8601_sequential_parser and appended to the encoded bit stream at once, so a column is never
+// held as an array of 8-byte values.
+template <typename Duration = std::chrono::milliseconds>
+class iso8601_delta_encoder
+{
+public:
+    explicit iso8601_delta_encoder(iso8601_required required   = iso8601_required::YYYYMMDDhhmmss,
+                                   std::size_t      block_size = iso8601_delta_block_size)
+        : parser_(required)
+        , column_(block_size)
+    {
+        assert(block_size > 0);
+    }
+
+    // Parses date and appends its timestamp; nothing is appended on failure.
+    iso8601_error try_append(std::string_view date)
+    {
+        time_point<Duration> result;
+        if (auto error = parser_.try_parse(date, result))
+            return error;
+        append(result);
+        return {};
+    }
+
+    void append(std::string_view date)
+    {
+        if (auto error = try_append(date))
+            throw iso8601_parse_error(error);
+    }
+
+    void append(time_point<Duration> value)
+    {
+        // wrapping unsigned arithmetic, so that any sequence round-trips
+        const auto ticks{ static_cast<std::uint64_t>(value.time_since_epoch().count()) };
+        if (column_.size_ % column_.block_size_ == 0)
+        {
+            column_.blocks_.push_back({ ticks, position_ });
+            delta_ = 0;
+        }
+        else
+        {
+            const std::uint64_t delta{ ticks - previous_ };
+            const std::uint64_t code{ detail::zigzag_encode(delta - delta_) };
+            const detail::delta_class* kind{ detail::delta_classes };
+            while (kind->value_bits != 64 && code >> kind->value_bits != 0)
+                ++kind;
+            if (kind->value_bits == 0)
+                detail::append_bits(column_.words_, position_, kind->prefix, kind->prefix_bits);
+            else if (kind->prefix_bits + kind->value_bits <= 64)
+                detail::append_bits(column_.words_, position_, kind->prefix | code << kind->prefix_bits,
+                                    kind->prefix_bits + kind->value_bits);
+            else
+            {
+                detail::append_bits(column_.words_, position_, kind->prefix, kind->prefix_bits);
+                detail::append_bits(column_.words_, position_, code, kind->value_bits);
+            }
+            delta_ = delta;
+        }
+        previous_ = ticks;
+        ++column_.size_;
+    }
+
+    std::size_t size() const noexcept { return column_.size_; }
+
+    // Returns the column of timestamps appended so far and starts a new one.
+    iso8601_delta_column<Duration> finish()
+    {
+        iso8601_delta_column<Duration> result{ column_.block_size_ };
+        std::swap(result, column_);
+        position_ = 0;
+        parser_.reset();
+        return result;
+    }
+
+private:
+    iso8601_sequential_parser<Duration> parser_;
+    iso8601_delta_column<Duration>      column_;
+    std::size_t                         position_{ 0 };
+    std::uint64_t                       previous_{ 0 };
+    std::uint64_t                       delta_{ 0 };
+};
+
+} // namespace core::time
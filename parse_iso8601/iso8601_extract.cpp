@@ -0,0 +1,191 @@
+// Extracts timestamps from a log, CSV or NDJSON file:
+//
+//   iso8601_extract [options] file
+//
+//   --column N        zero-based column holding the timestamp (default 0)
+//   --delimiter C     column delimiter, 'tab' and 'space' are accepted as names (default ',')
+//   --key NAME        take the timestamp from string value of NAME in NDJSON lines instead
+//   --unit U          s, ms, us or ns (default ms)
+//   --required R      YYYY, YYYYMM, YYYYMMDD, YYYYMMDDhh, YYYYMMDDhhmm or YYYYMMDDhhmmss (default)
+//   --threads N       number of threads, 0 for all hardware threads (default)
+//   --output FILE     write one int64 per non-empty line in native byte order, counted in units
+//                     since epoch; lines without a valid timestamp are written as INT64_MIN
+//
+// Without --output, the number of valid and invalid lines and the range of timestamps are
+// printed.
+
+#include "format_iso8601.h"
+#include "iso8601_extract.h"
+#include "iso8601_mapped_file.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+using namespace core::time;
+
+namespace {
+
+struct options
+{
+    iso8601_field_locator locator;
+    std::string           key;
+    std::string           unit{ "ms" };
+    iso8601_required      required{ iso8601_required::YYYYMMDDhhmmss };
+    unsigned int          threads{ 0 };
+    std::string           output;
+    std::string           input;
+};
+
+int usage()
+{
+    std::fputs("usage: iso8601_extract [--column N] [--delimiter C] [--key NAME] [--unit s|ms|us|ns]\n"
+               "                       [--required YYYY...YYYYMMDDhhmmss] [--threads N]\n"
+               "                       [--output FILE] file\n",
+               stderr);
+    return 2;
+}
+
+bool parse_required(std::string_view name, iso8601_required& required)
+{
+    constexpr std::string_view names[]{ "YYYY",       "YYYYMM",       "YYYYMMDD",
+                                        "YYYYMMDDhh", "YYYYMMDDhhmm", "YYYYMMDDhhmmss" };
+    for (std::size_t i = 0; i < std::size(names); ++i)
+    {
+        if (names[i] == name)
+        {
+            required = static_cast<iso8601_required>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse_arguments(int argc, char** argv, options& result)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument{ argv[i] };
+        if (argument.substr(0, 2) != "--")
+        {
+            if (!result.input.empty())
+                return false;
+            result.input = argv[i];
+            continue;
+        }
+        if (i + 1 == argc)
+            return false;
+        const std::string_view value{ argv[++i] };
+        if (argument == "--column")
+            result.locator.column = std::strtoull(value.data(), nullptr, 10);
+        else if (argument == "--delimiter")
+        {
+            if (value == "tab")
+                result.locator.delimiter = '\t';
+            else if (value == "space")
+                result.locator.delimiter = ' ';
+            else if (value.size() == 1)
+                result.locator.delimiter = value[0];
+            else
+                return false;
+        }
+        else if (argument == "--key")
+            result.key = value;
+        else if (argument == "--unit")
+            result.unit = value;
+        else if (argument == "--required")
+        {
+            if (!parse_required(value, result.required))
+                return false;
+        }
+        else if (argument == "--threads")
+            result.threads = static_cast<unsigned int>(std::strtoul(value.data(), nullptr, 10));
+        else if (argument == "--output")
+            result.output = value;
+        else
+            return false;
+    }
+    result.locator.json_key = result.key;
+    return !result.input.empty();
+}
+
+template <typename Duration>
+int extract(const options& options, std::string_view data)
+{
+    if (options.output.empty())
+    {
+        const auto summary{ summarize_iso8601field<Duration>(data, options.locator, options.required,
+                                                             options.threads) };
+        std::printf("valid: %zu\ninvalid: %zu\n", summary.valid, summary.invalid);
+        if (summary.valid != 0)
+        {
+            const iso8601_format_options format{ true, 9 };
+            std::printf("min: %s\nmax: %s\n", format_iso8601(summary.min, format).c_str(),
+                        format_iso8601(summary.max, format).c_str());
+        }
+        return 0;
+    }
+
+    const auto chunks{ extract_iso8601field<Duration>(data, options.locator, options.required,
+                                                      options.threads) };
+    std::FILE* file{ std::fopen(options.output.c_str(), "wb") };
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "cannot open %s: %s\n", options.output.c_str(), std::strerror(errno));
+        return 1;
+    }
+    std::size_t values{ 0 };
+    std::size_t invalid{ 0 };
+    bool        written{ true };
+    for (const auto& chunk : chunks)
+    {
+        static_assert(sizeof(time_point<Duration>) == sizeof(std::int64_t));
+        written = written && std::fwrite(chunk.values.data(), sizeof(std::int64_t),
+                                         chunk.values.size(), file) == chunk.values.size();
+        values += chunk.values.size();
+        invalid += chunk.invalid;
+    }
+    written = std::fclose(file) == 0 && written;
+    if (!written)
+    {
+        std::fprintf(stderr, "cannot write %s\n", options.output.c_str());
+        return 1;
+    }
+    std::fprintf(stderr, "%zu values written, %zu invalid\n", values, invalid);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    options options;
+    if (!parse_arguments(argc, argv, options))
+        return usage();
+
+    try
+    {
+        const iso8601_mapped_file file{ options.input };
+        if (options.unit == "s")
+            return extract<std::chrono::seconds>(options, file.content());
+        if (options.unit == "ms")
+            return extract<std::chrono::milliseconds>(options, file.content());
+        if (options.unit == "us")
+            return extract<std::chrono::microseconds>(options, file.content());
+        if (options.unit == "ns")
+            return extract<std::chrono::nanoseconds>(options, file.content());
+        return usage();
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+}
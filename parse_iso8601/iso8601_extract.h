@@ -0,0 +1,241 @@
+#pragma once
+
+#include "parse_iso8601_parallel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace core::time {
+
+// Where the timestamp is found in each line of a log, CSV or NDJSON file.
+struct iso8601_field_locator
+{
+    // zero-based index of the delimited column, used if json_key is empty
+    std::size_t column{ 0 };
+    // column delimiter, e.g. ',' for CSV, '\t' for TSV or ' ' for logs; each delimiter starts a
+    // new column, so repeated delimiters produce empty columns
+    char delimiter{ ',' };
+    // key of a string value in NDJSON lines, matched at any nesting level
+    std::string_view json_key;
+};
+
+// Lines are split into chunks of about this size for parallel processing
+constexpr std::size_t iso8601_extract_chunk_size{ 1 << 20 };
+
+namespace detail {
+
+// Returns the column-th field of line, an empty view if there are fewer columns. Double-quoted
+// fields may contain delimiters and doubled quotes and are returned without enclosing quotes.
+inline std::string_view find_delimited_field(std::string_view line, std::size_t column,
+                                             char delimiter) noexcept
+{
+    constexpr auto npos{ std::string_view::npos };
+
+    std::size_t position{ 0 };
+    for (std::size_t index = 0;; ++index)
+    {
+        const std::size_t begin{ position };
+        if (position < line.size() && line[position] == '"')
+        {
+            std::size_t end{ line.find('"', position + 1) };
+            while (end != npos && end + 1 < line.size() && line[end + 1] == '"')
+                end = line.find('"', end + 2);
+            if (end == npos)
+                return {};
+            if (index == column)
+                return line.substr(begin + 1, end - begin - 1);
+            position = line.find(delimiter, end + 1);
+        }
+        else
+        {
+            position = line.find(delimiter, position);
+            if (index == column)
+                return line.substr(begin, position == npos ? npos : position - begin);
+        }
+        if (position == npos)
+            return {};
+        ++position;
+    }
+}
+
+// Returns the string value following '"key":', an empty view if there is none. Values are not
+// unescaped, which timestamps never need.
+inline std::string_view find_json_string(std::string_view line, std::string_view key) noexcept
+{
+    constexpr auto npos{ std::string_view::npos };
+    auto           skip_spaces = [&line](std::size_t position) {
+        while (position < line.size() && (line[position] == ' ' || line[position] == '\t'))
+            ++position;
+        return position;
+    };
+
+    for (std::size_t position = line.find(key); position != npos;
+         position             = line.find(key, position + 1))
+    {
+        std::size_t end{ position + key.size() };
+        if (position == 0 || line[position - 1] != '"' || end >= line.size() || line[end] != '"')
+            continue;
+        end = skip_spaces(end + 1);
+        if (end >= line.size() || line[end] != ':')
+            continue;
+        end = skip_spaces(end + 1);
+        if (end >= line.size() || line[end] != '"')
+            return {};
+        const std::size_t value_end{ line.find('"', end + 1) };
+        if (value_end == npos)
+            return {};
+        return line.substr(end + 1, value_end - end - 1);
+    }
+    return {};
+}
+
+// Splits data into chunks of about chunk_size bytes, each ending after a line feed or at the
+// end of data.
+inline std::vector<std::string_view> split_line_chunks(std::string_view data,
+                                                       std::size_t      chunk_size)
+{
+    assert(chunk_size > 0);
+    std::vector<std::string_view> chunks;
+    chunks.reserve(data.size() / chunk_size + 1);
+    while (!data.empty())
+    {
+        std::size_t size{ data.size() };
+        if (chunk_size < data.size())
+        {
+            const void* line_feed{ std::memchr(data.data() + chunk_size, '\n',
+                                               data.size() - chunk_size) };
+            if (line_feed != nullptr)
+                size = static_cast<std::size_t>(static_cast<const char*>(line_feed) - data.data()) +
+                       1;
+        }
+        chunks.push_back(data.substr(0, size));
+        data.remove_prefix(size);
+    }
+    return chunks;
+}
+
+// Calls process(line) for each non-empty line of chunk, without the line terminator.
+template <typename Process>
+inline void for_each_line(std::string_view chunk, Process process)
+{
+    while (!chunk.empty())
+    {
+        const void*       line_feed{ std::memchr(chunk.data(), '\n', chunk.size()) };
+        const std::size_t length{
+            line_feed != nullptr
+                ? static_cast<std::size_t>(static_cast<const char*>(line_feed) - chunk.data())
+                : chunk.size()
+        };
+        std::string_view line{ chunk.substr(0, length) };
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+        if (!line.empty())
+            process(line);
+        chunk.remove_prefix(std::min(length + 1, chunk.size()));
+    }
+}
+
+} // namespace detail
+
+// Returns the field of line selected by locator, a view into line.
+inline std::string_view find_iso8601_field(std::string_view                line,
+                                           const iso8601_field_locator& locator) noexcept
+{
+    if (!locator.json_key.empty())
+        return detail::find_json_string(line, locator.json_key);
+    return detail::find_delimited_field(line, locator.column, locator.delimiter);
+}
+
+// Timestamps of a chunk of lines in line order; lines without a valid timestamp hold
+// time_point::min().
+template <typename Duration>
+struct iso8601_extract_chunk
+{
+    std::vector<time_point<Duration>> values;
+    std::size_t                       invalid{ 0 };
+};
+
+// Parses the field selected by locator in each non-empty line of data, e.g. the content of an
+// iso8601_mapped_file. Chunks ending at line boundaries are processed in parallel, fields are
+// parsed in place; concatenated chunks hold one value per line.
+template <typename Duration = std::chrono::milliseconds>
+inline std::vector<iso8601_extract_chunk<Duration>>
+extract_iso8601field(std::string_view data, const iso8601_field_locator& locator,
+                     iso8601_required required   = iso8601_required::YYYYMMDDhhmmss,
+                     unsigned int     threads    = 0,
+                     std::size_t      chunk_size = iso8601_extract_chunk_size)
+{
+    const auto                                   chunks{ detail::split_line_chunks(data, chunk_size) };
+    std::vector<iso8601_extract_chunk<Duration>> result(chunks.size());
+
+    detail::run_parallel(chunks.size(), threads, [&](std::size_t chunk) {
+        auto& extracted{ result[chunk] };
+        // lines of timestamps are rarely shorter than this
+        extracted.values.reserve(chunks[chunk].size() / 32);
+        detail::for_each_line(chunks[chunk], [&extracted, &locator, required](std::string_view line) {
+            time_point<Duration> value;
+            if (try_parse_iso8601datetime(find_iso8601_field(line, locator), value, required))
+            {
+                value = time_point<Duration>::min();
+                ++extracted.invalid;
+            }
+            extracted.values.push_back(value);
+        });
+    });
+    return result;
+}
+
+// Count and range of timestamps; min and max are meaningful only if valid is not 0.
+template <typename Duration>
+struct iso8601_extract_summary
+{
+    std::size_t          valid{ 0 };
+    std::size_t          invalid{ 0 };
+    time_point<Duration> min{ time_point<Duration>::max() };
+    time_point<Duration> max{ time_point<Duration>::min() };
+};
+
+// Same as extract_iso8601field, but only counts and range are kept, so memory use does not
+// grow with the size of data.
+template <typename Duration = std::chrono::milliseconds>
+inline iso8601_extract_summary<Duration>
+summarize_iso8601field(std::string_view data, const iso8601_field_locator& locator,
+                       iso8601_required required   = iso8601_required::YYYYMMDDhhmmss,
+                       unsigned int     threads    = 0,
+                       std::size_t      chunk_size = iso8601_extract_chunk_size)
+{
+    const auto chunks{ detail::split_line_chunks(data, chunk_size) };
+    std::vector<iso8601_extract_summary<Duration>> summaries(chunks.size());
+
+    detail::run_parallel(chunks.size(), threads, [&](std::size_t chunk) {
+        auto& summary{ summaries[chunk] };
+        detail::for_each_line(chunks[chunk], [&summary, &locator, required](std::string_view line) {
+            time_point<Duration> value;
+            if (try_parse_iso8601datetime(find_iso8601_field(line, locator), value, required))
+            {
+                ++summary.invalid;
+                return;
+            }
+            ++summary.valid;
+            summary.min = std::min(summary.min, value);
+            summary.max = std::max(summary.max, value);
+        });
+    });
+
+    iso8601_extract_summary<Duration> result;
+    for (const auto& summary : summaries)
+    {
+        result.valid += summary.valid;
+        result.invalid += summary.invalid;
+        result.min = std::min(result.min, summary.min);
+        result.max = std::max(result.max, summary.max);
+    }
+    return result;
+}
+
+} // namespace core::time
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace core::time {
+
+// Parser for timestamps that arrive in pieces, e.g. split across network buffers, so that they
+// need not be copied into a contiguous string first. Characters are passed through the state
+// machine of the table-driven engine as they are fed; only the table state, the values of
+// components read so far and the fraction digits reduced as by convert_fraction are kept.
+// Results and errors are those of try_parse_iso8601datetime for the concatenated input, except
+// that for input longer than iso8601_max_parse_length an error within the first characters takes
+// precedence.
+template <typename Duration = std::chrono::seconds>
+class iso8601_incremental_parser
+{
+public:
+    explicit iso8601_incremental_parser(
+        iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+        iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+        : required_(required)
+        , rounding_(rounding)
+    {
+    }
+
+    // Reads the next piece of the timestamp. Returns an error as soon as the characters read so
+    // far cannot start a valid timestamp; further pieces are then ignored and the error is
+    // returned again until the timestamp is finished or the parser reset.
+    iso8601_error feed(std::string_view piece) noexcept
+    {
+        using detail::table_mark;
+
+        if (error_)
+            return error_;
+        if (length_ == 0 && read_canonical(piece))
+            piece.remove_prefix(detail::canonical_length);
+        for (const char ch : piece)
+        {
+            if (length_ == iso8601_max_parse_length)
+                return error_ = { iso8601_errc::input_too_long, iso8601_component::timezone_offset,
+                                  iso8601_max_parse_length };
+
+            const auto cls{ detail::table_character_classes.data[static_cast<unsigned char>(ch)] };
+            const detail::table_transition transition{
+                detail::iso8601_parser_table.transitions[state_][static_cast<std::size_t>(cls)]
+            };
+            // an invalid offset sign is reported where the designator has been expected
+            if (transition.mark == table_mark::offset)
+                offset_position_ = length_;
+            if (transition.next >= table::accept)
+                return error_ = error_at(transition.next);
+            state_ = transition.next;
+            record(transition.mark, static_cast<unsigned int>(ch - '0'),
+                   cls == detail::table_class::digit);
+            ++length_;
+        }
+        return {};
+    }
+
+    // Ends the timestamp and stores it into result. The parser is reset for the next timestamp,
+    // also on failure.
+    iso8601_error try_finish(time_point<Duration>& result) noexcept
+    {
+        const iso8601_error error{ complete(result) };
+        reset();
+        return error;
+    }
+
+    time_point<Duration> finish()
+    {
+        time_point<Duration> result;
+        if (auto error = try_finish(result))
+            throw iso8601_parse_error(error);
+        return result;
+    }
+
+    // number of characters fed since the last timestamp
+    std::size_t size() const noexcept { return length_; }
+
+    // discards the characters fed so far
+    void reset() noexcept
+    {
+        state_           = table::year_0;
+        component_       = 0;
+        marks_           = 0;
+        length_          = 0;
+        offset_position_ = 0;
+        for (auto& value : components_)
+            value = 0;
+        fraction_           = {};
+        fraction_component_ = 0;
+        decimals_           = 0;
+        residue_            = detail::fraction_residue::zero;
+        error_              = {};
+    }
+
+private:
+    using table = detail::parser_table;
+
+    // components in the order of table marks month to offset_minutes, preceded by year
+    static constexpr std::size_t component_count{
+        static_cast<std::size_t>(detail::table_mark::offset_minutes) + 2
+    };
+
+    static constexpr detail::fraction_scale fraction_scales[]{
+        detail::make_fraction_scale(Duration::period::den * 60 * 60),
+        detail::make_fraction_scale(Duration::period::den * 60),
+        detail::make_fraction_scale(Duration::period::den)
+    };
+
+    // Reads 'YYYY-MM-DDThh:mm:ss' at the start of a timestamp at once with the canonical fast
+    // path, leaving the state machine where it would be after these characters. Returns false
+    // without reading anything if piece does not start with it.
+    bool read_canonical(std::string_view piece) noexcept
+    {
+        using detail::table_mark;
+
+        detail::canonical_head head;
+        if (!detail::parse_iso8601_canonical_head(piece, head) || piece[16] != ':' ||
+            static_cast<unsigned int>(piece[17] - '0') > 9 ||
+            static_cast<unsigned int>(piece[18] - '0') > 9)
+            return false;
+
+        components_[0] = head.year;
+        components_[1] = head.month;
+        components_[2] = head.day;
+        components_[3] = head.hours;
+        components_[4] = static_cast<unsigned int>(piece[14] - '0') * 10 +
+                         static_cast<unsigned int>(piece[15] - '0');
+        components_[5] = static_cast<unsigned int>(piece[17] - '0') * 10 +
+                         static_cast<unsigned int>(piece[18] - '0');
+        component_     = 5;
+        for (auto mark : { table_mark::extended, table_mark::month, table_mark::day,
+                           table_mark::hours, table_mark::minutes, table_mark::seconds })
+            marks_ |= std::uint32_t{ 1 } << static_cast<unsigned int>(mark);
+        state_  = table::time_state(2, 2, true);
+        length_ = detail::canonical_length;
+        return true;
+    }
+
+    bool marked(detail::table_mark mark) const noexcept
+    {
+        return (marks_ >> static_cast<unsigned int>(mark)) & 1;
+    }
+
+    void record(detail::table_mark mark, unsigned int digit, bool is_digit) noexcept
+    {
+        using detail::table_mark;
+
+        marks_ |= std::uint32_t{ 1 } << static_cast<unsigned int>(mark);
+        if (mark <= table_mark::offset_minutes)
+        {
+            // first digit of a component
+            component_              = static_cast<std::size_t>(mark) + 1;
+            components_[component_] = digit;
+        }
+        else if (mark >= table_mark::hours_fraction_begin && mark <= table_mark::seconds_fraction_begin)
+        {
+            // as in the engines, the last non-empty fraction determines decimals
+            convert_fraction();
+            fraction_           = {};
+            fraction_component_ = static_cast<std::size_t>(mark) -
+                                  static_cast<std::size_t>(table_mark::hours_fraction_begin);
+        }
+        else if (mark >= table_mark::hours_fraction_end && mark <= table_mark::seconds_fraction_end)
+            fraction_.push(digit, fraction_scales[fraction_component_]);
+        else if (mark == table_mark::none && is_digit)
+            components_[component_] = components_[component_] * 10 + digit;
+    }
+
+    void convert_fraction() noexcept
+    {
+        fraction_.convert(fraction_scales[fraction_component_], rounding_, decimals_, residue_);
+    }
+
+    iso8601_error error_at(unsigned char state) const noexcept
+    {
+        const auto code{ static_cast<iso8601_errc>((state - table::error_0) /
+                                                   table::component_count) };
+        const auto component{ static_cast<iso8601_component>((state - table::error_0) %
+                                                             table::component_count) };
+        return { code, component,
+                 code == iso8601_errc::invalid_offset_sign ? offset_position_ : length_ };
+    }
+
+    iso8601_error complete(time_point<Duration>& result) noexcept
+    {
+        using detail::table_mark;
+
+        if (error_)
+            return error_;
+        const unsigned char state{
+            detail::iso8601_parser_table
+                .transitions[state_][static_cast<std::size_t>(detail::table_class::end)]
+                .next
+        };
+        if (state >= table::error_0)
+            return error_at(state);
+
+        detail::iso8601_fields fields;
+        fields.date_components[0] = components_[0];
+        if (marked(table_mark::month))
+            fields.date_components[1] = components_[1];
+        if (marked(table_mark::day))
+            fields.date_components[2] = components_[2];
+        for (std::size_t i = 0; i < 3; ++i)
+            fields.time_components[i] = components_[3 + i];
+        fields.offset = { state != table::accept_negative, components_[6], components_[7] };
+        fields.parsed = marked(table_mark::month) + marked(table_mark::day) +
+                        marked(table_mark::date_extra) + marked(table_mark::hours) +
+                        marked(table_mark::minutes) + marked(table_mark::seconds);
+        fields.extended        = marked(table_mark::extended);
+        fields.offset_position = offset_position_;
+        convert_fraction();
+        fields.decimals = decimals_;
+        fields.residue  = residue_;
+        return detail::convert_fields(fields, length_, result, required_, rounding_);
+    }
+
+    iso8601_required        required_;
+    iso8601_rounding        rounding_;
+    unsigned char           state_{ table::year_0 };
+    std::size_t             component_{ 0 };
+    std::uint32_t           marks_{ 0 };
+    std::size_t             length_{ 0 };
+    std::size_t             offset_position_{ 0 };
+    unsigned int            components_[component_count]{};
+    detail::fraction_digits fraction_;
+    std::size_t             fraction_component_{ 0 };
+    unsigned long long      decimals_{ 0 };
+    detail::fraction_residue residue_{ detail::fraction_residue::zero };
+    iso8601_error           error_;
+};
+
+} // namespace core::time
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace core::time {
+
+// Read-only memory mapping of a whole file, so that its content can be scanned in place without
+// copying. Throws std::system_error if the file cannot be opened or mapped; an empty file yields
+// an empty view.
+class iso8601_mapped_file
+{
+public:
+    explicit iso8601_mapped_file(const std::string& path)
+    {
+#if defined(_WIN32)
+        file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE)
+            throw std::system_error(last_error(), "cannot open " + path);
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size))
+            fail("cannot get size of " + path);
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0)
+            return;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping_ == nullptr)
+            fail("cannot map " + path);
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_ == nullptr)
+            fail("cannot map " + path);
+#else
+        file_ = ::open(path.c_str(), O_RDONLY);
+        if (file_ < 0)
+            throw std::system_error(last_error(), "cannot open " + path);
+        struct stat status;
+        if (::fstat(file_, &status) != 0)
+            fail("cannot get size of " + path);
+        size_ = static_cast<std::size_t>(status.st_size);
+        if (size_ == 0)
+            return;
+        void* data{ ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0) };
+        if (data == MAP_FAILED)
+            fail("cannot map " + path);
+        data_ = static_cast<const char*>(data);
+        // the content is read front to back once
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+#endif
+    }
+
+    iso8601_mapped_file(const iso8601_mapped_file&) = delete;
+    iso8601_mapped_file& operator=(const iso8601_mapped_file&) = delete;
+
+    ~iso8601_mapped_file() { close(); }
+
+    std::string_view content() const noexcept { return { data_, size_ }; }
+
+private:
+    static std::error_code last_error() noexcept
+    {
+#if defined(_WIN32)
+        return { static_cast<int>(GetLastError()), std::system_category() };
+#else
+        return { errno, std::generic_category() };
+#endif
+    }
+
+    // releases what has been acquired so far, the destructor does not run for a constructor
+    // that throws
+    [[noreturn]] void fail(const std::string& what)
+    {
+        const std::error_code error{ last_error() };
+        close();
+        throw std::system_error(error, what);
+    }
+
+    void close() noexcept
+    {
+#if defined(_WIN32)
+        if (data_ != nullptr)
+            UnmapViewOfFile(data_);
+        if (mapping_ != nullptr)
+            CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE)
+            CloseHandle(file_);
+        mapping_ = nullptr;
+        file_    = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr)
+            ::munmap(const_cast<char*>(data_), size_);
+        if (file_ >= 0)
+            ::close(file_);
+        file_ = -1;
+#endif
+        data_ = nullptr;
+    }
+
+#if defined(_WIN32)
+    HANDLE file_{ INVALID_HANDLE_VALUE };
+    HANDLE mapping_{ nullptr };
+#else
+    int file_{ -1 };
+#endif
+    const char* data_{ nullptr };
+    std::size_t size_{ 0 };
+};
+
+} // namespace core::time
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "format_iso8601.h"
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ratio>
+#include <string_view>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
+
+namespace core::time {
+
+namespace detail {
+
+// loads 8 characters so that the first one ends up in the most significant byte, i.e. unsigned
+// comparison of the results orders strings as memcmp does
+inline std::uint64_t load_be64(const char* p) noexcept
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(load_le64(p));
+#else
+    return __builtin_bswap64(load_le64(p));
+#endif
+}
+
+// first 19 characters of the canonical layout as three overlapping big-endian words
+struct canonical_prefix
+{
+    std::uint64_t words[3];
+
+    explicit canonical_prefix(const char* p) noexcept
+        : words{ load_be64(p), load_be64(p + 8), load_be64(p + canonical_length - 8) }
+    {
+    }
+
+    // negative, zero or positive as memcmp of the characters
+    int compare(const canonical_prefix& other) const noexcept
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            if (words[i] != other.words[i])
+                return words[i] < other.words[i] ? -1 : 1;
+        }
+        return 0;
+    }
+};
+
+} // namespace detail
+
+// Predicate telling whether a string parses into a time point within [begin, end), as
+// try_parse_iso8601datetime followed by a comparison would. Strings in canonical UTC layout
+// 'YYYY-MM-DDThh:mm:ss[.fff...][Z]' sort like the time points they denote, so they are decided by
+// comparing their first 19 characters with those of the bounds; only strings within the second of
+// a bound are parsed in full. Other layouts, e.g. with offsets or in basic format, are parsed.
+template <typename Duration = std::chrono::seconds>
+class iso8601_range_filter
+{
+public:
+    iso8601_range_filter(time_point<Duration> begin, time_point<Duration> end,
+                         iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+        : begin_(begin)
+        , end_(end)
+        , required_(required)
+        , begin_prefix_(make_prefix(begin))
+        , end_prefix_(make_prefix(end))
+    {
+    }
+
+    bool operator()(std::string_view date) const noexcept
+    {
+        // with coarser units, truncation towards zero may move a time point across a bound
+        if constexpr (Duration::period::num == 1)
+        {
+            if (is_canonical_layout(date))
+            {
+                const detail::canonical_prefix prefix{ date.data() };
+                const int                      after_begin{ prefix.compare(begin_prefix_) };
+                const int                      before_end{ prefix.compare(end_prefix_) };
+                if (after_begin > 0 && before_end < 0)
+                    return detail::is_valid_iso8601_canonical<Duration>(date) || contains(date);
+                // an invalid string is outside the range as well
+                if ((after_begin < 0 || before_end > 0) && !has_offset(date))
+                    return false;
+            }
+        }
+        return contains(date);
+    }
+
+    time_point<Duration> begin() const noexcept { return begin_; }
+
+    time_point<Duration> end() const noexcept { return end_; }
+
+private:
+    // First 19 characters of the canonical layout of the second containing tp. Bounds beyond
+    // years 0000-9999 are replaced by strings that sort before or after all valid ones.
+    static detail::canonical_prefix make_prefix(time_point<Duration> tp) noexcept
+    {
+        using day_duration = std::chrono::duration<long long, std::ratio<86400>>;
+
+        const long long seconds{
+            std::chrono::floor<std::chrono::seconds>(tp.time_since_epoch()).count()
+        };
+        const long long day{
+            std::chrono::floor<day_duration>(std::chrono::seconds{ seconds }).count()
+        };
+        // room for the 8-byte store of write_time_of_day
+        char buffer[detail::canonical_length + 5];
+        if (day < detail::first_formatted_day)
+            std::memcpy(buffer, "0000-00-00T00:00:00", detail::canonical_length);
+        else if (day > detail::last_formatted_day)
+            std::memcpy(buffer, "9999-99-99T99:99:99", detail::canonical_length);
+        else
+        {
+            char* p{ detail::write_date(buffer, detail::civil_from_days(day), true) };
+            detail::write_time_of_day(p, static_cast<unsigned int>(seconds - day * 86400), true);
+        }
+        return detail::canonical_prefix{ buffer };
+    }
+
+    // Checks the separators of the canonical layout. Digits are checked only for strings inside
+    // the range, as invalid strings are outside of it anyway. Leap seconds and 24:00, which sort
+    // differently from their time points, are left to the parser.
+    static bool is_canonical_layout(std::string_view date) noexcept
+    {
+        if (date.size() < detail::canonical_length)
+            return false;
+        const char* p{ date.data() };
+        // '-' of 'YYYY-MM-' and 'T', ':' of 'DDThh:mm'
+        return (detail::load_le64(p) & 0xff0000ff00000000) == 0x2d00002d00000000 &&
+               (detail::load_le64(p + 8) & 0x0000ff0000ff0000) == 0x00003a0000540000 &&
+               p[16] == ':' && p[17] <= '5' && (p[11] < '2' || (p[11] == '2' && p[12] <= '3'));
+    }
+
+    // Offsets start with '+', '-' or the first byte of UTF-8 minus sign. A string ending with 'Z'
+    // is not valid with an offset.
+    static bool has_offset(std::string_view date) noexcept
+    {
+        if (date.back() == 'Z')
+            return false;
+        for (std::size_t i = detail::canonical_length; i < date.size(); ++i)
+        {
+            if (date[i] == '+' || date[i] == '-' || date[i] == '\xe2')
+                return true;
+        }
+        return false;
+    }
+
+    bool contains(std::string_view date) const noexcept
+    {
+        time_point<Duration> result;
+        return !try_parse_iso8601datetime(date, result, required_) && result >= begin_ &&
+               result < end_;
+    }
+
+    time_point<Duration>     begin_;
+    time_point<Duration>     end_;
+    iso8601_required         required_;
+    detail::canonical_prefix begin_prefix_;
+    detail::canonical_prefix end_prefix_;
+};
+
+} // namespace core::time
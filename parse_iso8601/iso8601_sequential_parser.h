@@ -0,0 +1,66 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+namespace core::time {
+
+// Parser for nearly monotonic streams, such as log files, in which consecutive timestamps usually
+// share the 'YYYY-MM-DDThh' prefix. The prefix of the last canonical timestamp is kept together
+// with its hours since epoch, so that for a matching input only 'mm:ss[.fff...][Z]' is converted
+// and calendar validation and arithmetic are skipped. Results are equal to those of
+// try_parse_iso8601datetime/parse_iso8601datetime.
+template <typename Duration = std::chrono::seconds>
+class iso8601_sequential_parser
+{
+public:
+    explicit iso8601_sequential_parser(
+        iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+        : required_(required)
+    {
+    }
+
+    iso8601_error try_parse(std::string_view date, time_point<Duration>& result) noexcept
+    {
+        if (has_prefix_ && date.size() >= detail::canonical_length &&
+            std::memcmp(date.data(), prefix_, detail::canonical_hour_length) == 0)
+        {
+            detail::canonical_tail tail;
+            if (detail::parse_iso8601_canonical_tail<Duration>(date, tail))
+            {
+                result = detail::canonical_time_point<Duration>(epoch_hours_, tail);
+                return {};
+            }
+        }
+        if (detail::parse_iso8601_canonical(date, result, epoch_hours_))
+        {
+            date.copy(prefix_, detail::canonical_hour_length);
+            has_prefix_ = true;
+            return {};
+        }
+        return detail::parse_iso8601_engine(date, result, required_);
+    }
+
+    time_point<Duration> parse(std::string_view date)
+    {
+        time_point<Duration> result;
+        if (auto error = try_parse(date, result))
+            throw iso8601_parse_error(error);
+        return result;
+    }
+
+    // forgets the cached prefix
+    void reset() noexcept { has_prefix_ = false; }
+
+private:
+    iso8601_required required_;
+    bool             has_prefix_{ false };
+    char             prefix_[detail::canonical_hour_length]{};
+    long long        epoch_hours_{ 0 };
+};
+
+} // namespace core::time
@@ -1,10 +1,15 @@
 #pragma once
 
-#include <date/date.h>
-#include <boost/logic/tribool.hpp>
-
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <ratio>
 #include <stdexcept>
+#include <string>
 #include <string_view>
 
 namespace core::time {
@@ -19,170 +24,833 @@ enum class iso8601_required
     YYYYMMDDhhmmss,
 };
 
+// rounding of fraction digits finer than Duration resolution
+enum class iso8601_rounding
+{
+    // digits finer than Duration::period::den units are dropped, so a fraction is never rounded
+    // up, also before epoch; with Durations coarser than a second the result is then truncated
+    // towards zero, as by std::chrono::duration_cast
+    truncate,
+    // towards the past
+    floor,
+    // to the nearest tick, ties to even as in std::chrono::round
+    nearest,
+};
+
+// longer strings are rejected by the general parser before any character is examined
+constexpr std::size_t iso8601_max_parse_length{ 64 };
+
 template <class Duration = std::chrono::seconds>
 using time_point = std::chrono::time_point<std::chrono::system_clock, Duration>;
 
-template <typename Duration = std::chrono::seconds>
-inline time_point<Duration>
-parse_iso8601datetime(std::string_view date,
-                      iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+enum class iso8601_errc
 {
-    // helper lambdas
-    auto is_digit = [](const char ch) { return ch >= '0' && ch <= '9'; };
+    ok,
+    not_a_digit,
+    missing_digit,
+    invalid_offset_sign,
+    separator_missing,
+    incomplete_date,
+    missing_date_time_delimiter,
+    missing_offset_separator,
+    invalid_termination,
+    incomplete_time,
+    invalid_date,
+    invalid_time,
+    invalid_timezone_offset,
+    input_too_long,
+};
 
-    auto to_digit = [&is_digit](const char ch) {
-        if (!is_digit(ch))
-            throw std::runtime_error("Not a digit");
-        return ch - '0';
-    };
+inline const char* iso8601_error_message(iso8601_errc error) noexcept
+{
+    switch (error)
+    {
+    case iso8601_errc::ok:
+        return "Success";
+    case iso8601_errc::not_a_digit:
+        return "Not a digit";
+    case iso8601_errc::missing_digit:
+        return "Missing digit";
+    case iso8601_errc::invalid_offset_sign:
+        return "Invalid time offset sign";
+    case iso8601_errc::separator_missing:
+        return "Separator missing";
+    case iso8601_errc::incomplete_date:
+        return "Incomplete date";
+    case iso8601_errc::missing_date_time_delimiter:
+        return "Delimiter 'T' is missing after date";
+    case iso8601_errc::missing_offset_separator:
+        return "Missing time offset separator";
+    case iso8601_errc::invalid_termination:
+        return "Invalid termination";
+    case iso8601_errc::incomplete_time:
+        return "Incomplete time";
+    case iso8601_errc::invalid_date:
+        return "Invalid date";
+    case iso8601_errc::invalid_time:
+        return "Invalid time";
+    case iso8601_errc::invalid_timezone_offset:
+        return "Invalid timezone offset";
+    case iso8601_errc::input_too_long:
+        return "Input too long";
+    }
+    return "Unknown error";
+}
 
-    auto integer = [&to_digit, &date](int digits) {
-        unsigned int number{ 0 };
-        while (digits-- > 0)
+// component of the date and time string in which an error has been detected
+enum class iso8601_component
+{
+    year,
+    month,
+    day,
+    hours,
+    minutes,
+    seconds,
+    timezone_offset,
+};
+
+inline const char* iso8601_component_name(iso8601_component component) noexcept
+{
+    switch (component)
+    {
+    case iso8601_component::year:
+        return "year";
+    case iso8601_component::month:
+        return "month";
+    case iso8601_component::day:
+        return "day";
+    case iso8601_component::hours:
+        return "hours";
+    case iso8601_component::minutes:
+        return "minutes";
+    case iso8601_component::seconds:
+        return "seconds";
+    case iso8601_component::timezone_offset:
+        return "timezone offset";
+    }
+    return "unknown";
+}
+
+// Describes why and where parsing failed. Trivially copyable, so reporting an error does not
+// allocate; the human-readable text is formatted only when message() is called.
+struct iso8601_error
+{
+    iso8601_errc      code{ iso8601_errc::ok };
+    iso8601_component component{ iso8601_component::year };
+    // byte offset inside the parsed string
+    std::size_t offset{ 0 };
+
+    constexpr explicit operator bool() const noexcept { return code != iso8601_errc::ok; }
+
+    std::string message() const
+    {
+        std::string result{ iso8601_error_message(code) };
+        if (code != iso8601_errc::ok)
         {
-            if (date.empty())
-                throw std::runtime_error("Missing digit");
-            number = number * 10 + to_digit(date[0]);
-            date.remove_prefix(1);
+            result += " (";
+            result += iso8601_component_name(component);
+            result += " at offset ";
+            result += std::to_string(offset);
+            result += ')';
         }
-        return number;
+        return result;
+    }
+};
+
+class iso8601_parse_error : public std::runtime_error
+{
+public:
+    explicit iso8601_parse_error(const iso8601_error& error)
+        : std::runtime_error(error.message())
+        , error_(error)
+    {
+    }
+
+    const iso8601_error& error() const noexcept { return error_; }
+
+private:
+    iso8601_error error_;
+};
+
+namespace detail {
+
+// Proleptic Gregorian calendar. Years start in March, so that the leap day is the last day of a
+// year and months have a regular length pattern; years are shifted by a multiple of 400 so that
+// all arithmetic is on non-negative numbers and compiles without branches.
+
+using days = std::chrono::duration<int, std::ratio<86400>>;
+
+// calendar date, month and day starting at 1
+struct civil_date
+{
+    int          year;
+    unsigned int month;
+    unsigned int day;
+};
+
+// years before -civil_year_shift are not supported
+constexpr int civil_year_shift{ 4800 };
+// days from 0000-03-01 to 1970-01-01 plus the days of the shift
+constexpr long long civil_day_shift{ 719468 + civil_year_shift / 400 * 146097LL };
+
+constexpr bool is_leap_year(int year) noexcept
+{
+    return (year % 4 == 0) & ((year % 100 != 0) | (year % 400 == 0));
+}
+
+constexpr bool is_valid_month(unsigned int month) noexcept { return month - 1 < 12; }
+
+// month must be valid
+constexpr unsigned int last_day_of_month(int year, unsigned int month) noexcept
+{
+    // months alternate between 31 and 30 days, with the phase changing after July
+    return month == 2 ? 28 + is_leap_year(year) : 30 + ((month ^ (month >> 3)) & 1);
+}
+
+constexpr bool is_valid_date(int year, unsigned int month, unsigned int day) noexcept
+{
+    return is_valid_month(month) && day - 1 < last_day_of_month(year, month);
+}
+
+// days since 1970-01-01, date must be valid
+constexpr long long days_from_civil(int year, unsigned int month, unsigned int day) noexcept
+{
+    const unsigned int before_march{ month <= 2 };
+    const auto         shifted_year{ static_cast<unsigned int>(year + civil_year_shift) -
+                             before_march };
+    const unsigned int era{ shifted_year / 400 };
+    const unsigned int year_of_era{ shifted_year - era * 400 };
+    const unsigned int month_from_march{ month + 9 - 12 * (1 - before_march) };
+    const unsigned int day_of_year{ (153 * month_from_march + 2) / 5 + day - 1 };
+    const unsigned int day_of_era{ year_of_era * 365 + year_of_era / 4 - year_of_era / 100 +
+                                   day_of_year };
+    return era * 146097LL + day_of_era - civil_day_shift;
+}
+
+// inverse of days_from_civil
+constexpr civil_date civil_from_days(long long days) noexcept
+{
+    const auto         shifted_days{ static_cast<unsigned long long>(days + civil_day_shift) };
+    const auto         era{ static_cast<unsigned int>(shifted_days / 146097) };
+    const auto         day_of_era{ static_cast<unsigned int>(shifted_days - era * 146097ULL) };
+    const unsigned int year_of_era{
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365
     };
+    const unsigned int day_of_year{ day_of_era -
+                                    (365 * year_of_era + year_of_era / 4 - year_of_era / 100) };
+    const unsigned int month_from_march{ (5 * day_of_year + 2) / 153 };
+    const unsigned int day{ day_of_year - (153 * month_from_march + 2) / 5 + 1 };
+    const unsigned int month{ month_from_march < 10 ? month_from_march + 3
+                                                    : month_from_march - 9 };
+    const int          year{ static_cast<int>(year_of_era + era * 400) - civil_year_shift +
+                    (month <= 2) };
+    return { year, month, day };
+}
+
+// loads 8 characters so that the first one ends up in the least significant byte
+inline std::uint64_t load_le64(const char* p) noexcept
+{
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    std::uint64_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+#else
+    std::uint64_t result{ 0 };
+    for (int i = 0; i < 8; ++i)
+        result |= std::uint64_t{ static_cast<unsigned char>(p[i]) } << (8 * i);
+    return result;
+#endif
+}
+
+// Checks that bytes selected by separator_mask match separators and that all other bytes are
+// digits. On success, byte i of pairs holds the two-digit number starting at byte i.
+inline bool swar_two_digit_numbers(std::uint64_t chunk, std::uint64_t separator_mask,
+                                   std::uint64_t separators, std::uint64_t& pairs) noexcept
+{
+    constexpr std::uint64_t zeros{ 0x3030303030303030 };
+
+    if ((chunk & separator_mask) != separators)
+        return false;
+    // replace separators by '0' so that they neither fail the check nor borrow from neighbours
+    const std::uint64_t digits{ (chunk & ~separator_mask) | (zeros & separator_mask) };
+    if (((digits + 0x4646464646464646) | (digits - zeros)) & 0x8080808080808080)
+        return false;
+    const std::uint64_t values{ digits - zeros };
+    pairs = values * 10 + (values >> 8);
+    return true;
+}
+
+constexpr unsigned int byte_at(std::uint64_t value, int index) noexcept
+{
+    return static_cast<unsigned int>(value >> (8 * index)) & 0xff;
+}
+
+constexpr std::size_t canonical_length{ 19 };
+// length of the 'YYYY-MM-DDThh' part of canonical layout
+constexpr std::size_t canonical_hour_length{ 13 };
+
+// minutes, seconds and fraction of canonical layout
+struct canonical_tail
+{
+    unsigned int       minutes;
+    unsigned int       seconds;
+    unsigned long long decimals;
+};
+
+// Second part of the canonical fast path: validates and converts 'mm:ss[.fff...][Z]' following
+// 'YYYY-MM-DDThh', decimals are expressed in Duration::period::den units.
+template <typename Duration>
+inline bool
+parse_iso8601_canonical_tail(std::string_view date, canonical_tail& tail,
+                             iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    // rounding of ticks is left to the general parser
+    if (rounding != iso8601_rounding::truncate && Duration::period::num != 1)
+        return false;
+
+    // reject offsets and other suffixes before doing any conversion
+    if (date.size() < canonical_length ||
+        (date.size() > canonical_length && date[canonical_length] != '.' &&
+         date[canonical_length] != ',' && date[canonical_length] != 'Z'))
+        return false;
+
+    std::uint64_t hms_pairs;
+    // 'hh:mm:ss'
+    if (!swar_two_digit_numbers(load_le64(date.data() + 11), 0x0000ff0000ff0000,
+                                0x00003a00003a0000, hms_pairs))
+        return false;
+
+    const unsigned int minutes{ byte_at(hms_pairs, 3) };
+    const unsigned int seconds{ byte_at(hms_pairs, 6) };
+
+    // leap second is rare enough to be left to the general parser
+    if (minutes > 59 || seconds > 59)
+        return false;
 
-    auto decimal = [&to_digit, &is_digit, &date](int digits) {
-        unsigned long long number{ 0 };
+    date.remove_prefix(canonical_length);
+
+    unsigned long long decimals{ 0 };
+    if (!date.empty() && (date[0] == '.' || date[0] == ','))
+    {
+        // limit fraction length so that the result cannot overflow and is equal to general parser's
+        constexpr int max_fraction_digits{ Duration::period::den <= 1000000000 ? 9 : 0 };
+
+        date.remove_prefix(1);
+        unsigned long long fraction{ 0 };
         unsigned long long divisor{ 1 };
-        while (digits-- > 0)
+        int                fraction_digits{ 0 };
+        while (!date.empty() && date[0] >= '0' && date[0] <= '9')
         {
-            if (date.empty())
-                throw std::runtime_error("Missing digit");
-            number = number * 10 + to_digit(date[0]);
+            if (++fraction_digits > max_fraction_digits)
+                return false;
+            fraction = fraction * 10 + (date[0] - '0');
+            divisor *= 10;
             date.remove_prefix(1);
         }
-        if (!date.empty() && (date[0] == '.' || date[0] == ','))
+        decimals = fraction * Duration::period::den / divisor;
+        // so are fractions that need rounding
+        if (rounding != iso8601_rounding::truncate &&
+            decimals * divisor != fraction * Duration::period::den)
+            return false;
+    }
+    if (!date.empty() && date[0] == 'Z')
+        date.remove_prefix(1);
+    if (!date.empty())
+        return false;
+
+    tail = { minutes, seconds, decimals };
+    return true;
+}
+
+template <typename Duration>
+inline time_point<Duration> canonical_time_point(long long             epoch_hours,
+                                                 const canonical_tail& tail) noexcept
+{
+    // digits finer than den units have been dropped; signed arithmetic, so that division by num
+    // truncates towards zero before epoch as with iso8601_rounding::truncate in general
+    auto count = (((epoch_hours * 60 + tail.minutes) * 60 + tail.seconds) * Duration::period::den +
+                  static_cast<long long>(tail.decimals)) /
+                 Duration::period::num;
+    return time_point<Duration>{ Duration{ count } };
+}
+
+// date and hour of canonical layout
+struct canonical_head
+{
+    unsigned int year;
+    unsigned int month;
+    unsigned int day;
+    unsigned int hours;
+};
+
+// First part of the canonical fast path: validates and converts 'YYYY-MM-DDThh'; hours above 23
+// are rejected, but the date is not checked yet.
+inline bool parse_iso8601_canonical_head(std::string_view date, canonical_head& head) noexcept
+{
+    if (date.size() < canonical_length)
+        return false;
+
+    const char*   p{ date.data() };
+    std::uint64_t ymd_pairs, dhm_pairs;
+    // 'YYYY-MM-' and 'DDThh:mm'
+    if (!swar_two_digit_numbers(load_le64(p), 0xff0000ff00000000, 0x2d00002d00000000,
+                                ymd_pairs) ||
+        !swar_two_digit_numbers(load_le64(p + 8), 0x0000ff0000ff0000, 0x00003a0000540000,
+                                dhm_pairs))
+        return false;
+
+    head = { byte_at(ymd_pairs, 0) * 100 + byte_at(ymd_pairs, 2), byte_at(ymd_pairs, 5),
+             byte_at(dhm_pairs, 0), byte_at(dhm_pairs, 3) };
+
+    // '24:00' is rare enough to be left to the general parser
+    return head.hours <= 23;
+}
+
+// Fast path for the canonical 'YYYY-MM-DDThh:mm:ss[.fff...][Z]' layout: all fixed-position
+// digits and separators are validated and converted with three 8-byte loads. Returns false for
+// any other layout or for values that need further checks, which are left to the general parser.
+// On success epoch_hours holds the hours since epoch of 'YYYY-MM-DDThh' part.
+template <typename Duration>
+inline bool parse_iso8601_canonical(std::string_view date, time_point<Duration>& result,
+                                    long long&       epoch_hours,
+                                    iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    canonical_head head;
+    canonical_tail tail;
+    if (!parse_iso8601_canonical_head(date, head) ||
+        !parse_iso8601_canonical_tail<Duration>(date, tail, rounding))
+        return false;
+
+    const int year{ static_cast<int>(head.year) };
+    if (!is_valid_date(year, head.month, head.day))
+        return false;
+
+    epoch_hours = days_from_civil(year, head.month, head.day) * 24 + head.hours;
+    result      = canonical_time_point<Duration>(epoch_hours, tail);
+    return true;
+}
+
+template <typename Duration>
+inline bool parse_iso8601_canonical(std::string_view date, time_point<Duration>& result,
+                                    iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    long long epoch_hours;
+    return parse_iso8601_canonical(date, result, epoch_hours, rounding);
+}
+
+// Validation counterpart of parse_iso8601_canonical, true only if the fast path would succeed.
+template <typename Duration>
+inline bool is_valid_iso8601_canonical(std::string_view date) noexcept
+{
+    canonical_head head;
+    canonical_tail tail;
+    if (!parse_iso8601_canonical_head(date, head) ||
+        !parse_iso8601_canonical_tail<Duration>(date, tail))
+        return false;
+
+    return is_valid_date(static_cast<int>(head.year), head.month, head.day);
+}
+
+// timezone offset shared by the parsers
+struct timezone_offset
+{
+    bool         positive;
+    unsigned int hours;
+    unsigned int minutes;
+
+    constexpr int to_minutes() const noexcept
+    {
+        int result = hours * 60 + minutes;
+        return positive ? result : -result;
+    }
+    // valid time zone offsets: https://en.wikipedia.org/wiki/List_of_UTC_time_offsets
+    constexpr bool ok() const noexcept
+    {
+        switch (minutes)
+        {
+        case 0:
+            return hours <= 12 || (positive && hours <= 14);
+        case 30:
+            if (positive)
+                switch (hours)
+                {
+                case 3:
+                case 4:
+                case 5:
+                case 6:
+                case 9:
+                case 10:
+                    return true;
+                }
+            else
+                switch (hours)
+                {
+                case 3:
+                case 9:
+                    return true;
+                }
+            return false;
+        case 45:
+            if (positive)
+                switch (hours)
+                {
+                case 5:
+                case 8:
+                case 12:
+                    return true;
+                }
+            return false;
+        default:
+            return false;
+        }
+    }
+};
+
+// Fraction digits of a component worth multiplier Duration::period::den units are accumulated
+// until the last one is worth exactly one unit, or as far as the value cannot overflow; the value
+// of accumulated digits is number * numerator / denominator units.
+struct fraction_scale
+{
+    int                digits;
+    unsigned long long numerator;
+    unsigned long long denominator;
+};
+
+constexpr fraction_scale make_fraction_scale(unsigned long long multiplier) noexcept
+{
+    constexpr unsigned long long max{ std::numeric_limits<unsigned long long>::max() };
+
+    fraction_scale     result{ 0, multiplier, 1 };
+    unsigned long long power{ 1 };
+    while (power != multiplier && power <= max / 10)
+    {
+        const unsigned long long next_power{ power * 10 };
+        const unsigned long long divisor{ std::gcd(multiplier, next_power) };
+        if (multiplier / divisor > max / next_power)
+            break;
+        power  = next_power;
+        result = { result.digits + 1, multiplier / divisor, next_power / divisor };
+    }
+    return result;
+}
+
+constexpr unsigned long long powers_of_10[]{ 1,
+                                             10,
+                                             100,
+                                             1000,
+                                             10000,
+                                             100000,
+                                             1000000,
+                                             10000000,
+                                             100000000,
+                                             1000000000,
+                                             10000000000,
+                                             100000000000,
+                                             1000000000000,
+                                             10000000000000,
+                                             100000000000000,
+                                             1000000000000000,
+                                             10000000000000000,
+                                             100000000000000000,
+                                             1000000000000000000,
+                                             10000000000000000000u };
+
+// part of a unit dropped from the fraction, relative to one half
+enum class fraction_residue
+{
+    zero,
+    below_half,
+    half,
+    above_half,
+};
+
+// Fraction digits of a component, read one at a time. Digits finer than scale are only
+// validated; the first of them and whether any of the following ones is non-zero are kept to
+// determine the residue for rounding.
+struct fraction_digits
+{
+    std::size_t        count{ 0 };
+    unsigned long long number{ 0 };
+    unsigned int       guard{ 0 };
+    bool               sticky{ false };
+
+    constexpr void push(unsigned int digit, const fraction_scale& scale) noexcept
+    {
+        const auto scale_digits{ static_cast<std::size_t>(scale.digits) };
+        if (count < scale_digits)
+            number = number * 10 + digit;
+        else if (count == scale_digits)
+            guard = digit;
+        else
+            sticky = sticky || digit != 0;
+        ++count;
+    }
+
+    // Converts digits pushed with scale into decimals, leaves decimals and residue untouched if
+    // there are none.
+    constexpr void convert(const fraction_scale& scale, iso8601_rounding rounding,
+                           unsigned long long& decimals, fraction_residue& residue) const noexcept
+    {
+        if (count == 0)
+            return;
+
+        const auto         scale_digits{ static_cast<std::size_t>(scale.digits) };
+        unsigned long long value{ number };
+        if (count < scale_digits)
+            value *= powers_of_10[scale_digits - count];
+        decimals = value * scale.numerator / scale.denominator;
+        if (rounding == iso8601_rounding::truncate)
+            return;
+
+        // remainder compared with one half, either of accumulated digits or of the guard digit
+        // if accumulated digits are exact
+        const bool               exact{ scale.denominator == 1 };
+        const unsigned long long remainder{ exact ? guard
+                                                  : value * scale.numerator % scale.denominator };
+        const unsigned long long unit{ exact ? 10 : scale.denominator };
+        const bool               rest{ exact ? sticky : guard != 0 || sticky };
+        if (remainder == 0 && !rest)
+            residue = fraction_residue::zero;
+        else if (2 * remainder < unit)
+            residue = fraction_residue::below_half;
+        else if (2 * remainder == unit && !rest)
+            residue = fraction_residue::half;
+        else
+            residue = fraction_residue::above_half;
+    }
+};
+
+// Converts fraction digits of a component into decimals, leaves decimals and residue untouched
+// if digits are empty. Same as pushing the digits one at a time, in a loop the compiler can
+// unroll.
+constexpr void convert_fraction(std::string_view digits, const fraction_scale& scale,
+                                iso8601_rounding rounding, unsigned long long& decimals,
+                                fraction_residue& residue) noexcept
+{
+    const auto      scale_digits{ static_cast<std::size_t>(scale.digits) };
+    fraction_digits fraction{ digits.size() };
+    for (std::size_t i = 0; i < digits.size(); ++i)
+    {
+        const unsigned int digit{ static_cast<unsigned int>(digits[i] - '0') };
+        if (i < scale_digits)
+            fraction.number = fraction.number * 10 + digit;
+        else if (i == scale_digits)
+            fraction.guard = digit;
+        else
+            fraction.sticky = fraction.sticky || digit != 0;
+    }
+    fraction.convert(scale, rounding, decimals, residue);
+}
+
+// Divides ticks, increased by residue, by divisor. With iso8601_rounding::truncate the residue is
+// dropped and ticks are divided towards zero.
+constexpr long long divide_rounded(long long ticks, fraction_residue residue, long long divisor,
+                                   iso8601_rounding rounding) noexcept
+{
+    if (rounding == iso8601_rounding::truncate)
+        return ticks / divisor;
+
+    long long quotient{ ticks / divisor };
+    long long remainder{ ticks % divisor };
+    if (remainder < 0)
+    {
+        --quotient;
+        remainder += divisor;
+    }
+    if (rounding == iso8601_rounding::floor)
+        return quotient;
+
+    // compare remainder + residue with divisor / 2
+    const long long twice{ 2 * remainder };
+    const bool      tie{ (twice == divisor && residue == fraction_residue::zero) ||
+                    (twice == divisor - 1 && residue == fraction_residue::half) };
+    const bool      up{ twice > divisor || (twice == divisor && residue != fraction_residue::zero) ||
+                   (twice == divisor - 1 && residue == fraction_residue::above_half) };
+    if (tie)
+        return quotient % 2 != 0 ? quotient + 1 : quotient;
+    return up ? quotient + 1 : quotient;
+}
+
+// Components collected by a parser engine, validated and converted by convert_fields.
+struct iso8601_fields
+{
+    // year, month, day and hours, minutes, seconds; plain arrays keep the parsers usable in
+    // constant expressions
+    unsigned int       date_components[3]{ 0, 1, 1 };
+    unsigned int       time_components[3]{ 0, 0, 0 };
+    unsigned long long decimals{ 0 };
+    fraction_residue   residue{ fraction_residue::zero };
+    timezone_offset    offset{ true, 0, 0 };
+    // number of components following the year
+    int parsed{ 0 };
+    // whether date and time use separators, false until known
+    bool extended{ false };
+    // start of the timezone designator
+    std::size_t offset_position{ 0 };
+};
+
+// Checks that required components are present and all are in range. Offsets of components that
+// fail validation are derived from the layout, which is fixed once separator usage is known.
+constexpr iso8601_error check_fields(const iso8601_fields& fields, std::size_t length,
+                                     iso8601_required required) noexcept
+{
+    auto fail_at = [&fields](iso8601_errc code, iso8601_component component) {
+        if (component == iso8601_component::timezone_offset)
+            return iso8601_error{ code, component, fields.offset_position };
+        // offsets in basic format, each preceding separator shifts component by one character
+        constexpr std::size_t starts[]{ 0, 4, 6, 9, 11, 13 };
+        const auto            index{ static_cast<std::size_t>(component) };
+        const std::size_t separators{ fields.extended ? (index < 3 ? index : index - 1) : 0 };
+        return iso8601_error{ code, component, starts[index] + separators };
+    };
+
+    if (fields.parsed < static_cast<int>(required))
+    {
+        const auto missing{ static_cast<iso8601_component>(fields.parsed + 1) };
+        if (fields.parsed < static_cast<int>(iso8601_required::YYYYMMDD))
+            return iso8601_error{ iso8601_errc::incomplete_date, missing, length };
+        return iso8601_error{ iso8601_errc::incomplete_time, missing, length };
+    }
+
+    const unsigned int month{ fields.date_components[1] };
+    if (!is_valid_date(static_cast<int>(fields.date_components[0]), month,
+                       fields.date_components[2]))
+        return fail_at(iso8601_errc::invalid_date, is_valid_month(month)
+                                                       ? iso8601_component::day
+                                                       : iso8601_component::month);
+
+    // 60 seconds is used to denote an added leap second
+    // "24:00" may be used for midnight
+    const unsigned int hours{ fields.time_components[0] };
+    const unsigned int minutes{ fields.time_components[1] };
+    const unsigned int seconds{ fields.time_components[2] };
+    if (minutes > 59)
+        return fail_at(iso8601_errc::invalid_time, iso8601_component::minutes);
+    if (seconds > 60 || (seconds == 60 && fields.decimals != 0))
+        return fail_at(iso8601_errc::invalid_time, iso8601_component::seconds);
+    if (hours > 24 || (hours == 24 && (minutes != 0 || seconds != 0 || fields.decimals != 0)))
+        return fail_at(iso8601_errc::invalid_time, iso8601_component::hours);
+
+    if (!fields.offset.ok())
+        return fail_at(iso8601_errc::invalid_timezone_offset, iso8601_component::timezone_offset);
+    return {};
+}
+
+// Checks parsed components and stores the time point into result.
+template <typename Duration>
+constexpr iso8601_error convert_fields(const iso8601_fields& fields, std::size_t length,
+                                       time_point<Duration>& result, iso8601_required required,
+                                       iso8601_rounding rounding) noexcept
+{
+    if (auto error = check_fields(fields, length, required))
+        return error;
+
+    const unsigned int hours{ fields.time_components[0] };
+    const unsigned int minutes{ fields.time_components[1] };
+    const unsigned int seconds{ fields.time_components[2] };
+
+    const long long days{ days_from_civil(static_cast<int>(fields.date_components[0]),
+                                          fields.date_components[1], fields.date_components[2]) };
+    long long ticks =
+        (((days * 24 + hours) * 60 + minutes - fields.offset.to_minutes()) * 60 + seconds) *
+            Duration::period::den +
+        static_cast<long long>(fields.decimals);
+    result = time_point<Duration>{ Duration{
+        divide_rounded(ticks, fields.residue, Duration::period::num, rounding) } };
+    return {};
+}
+
+// General scanner handling all supported layouts, usable in constant expressions. Fills fields
+// with components as they are read; they are checked and converted by the caller.
+template <typename Duration>
+constexpr iso8601_error scan_iso8601_general(std::string_view date, iso8601_fields& fields,
+                                             iso8601_rounding rounding) noexcept
+{
+    if (date.size() > iso8601_max_parse_length)
+        return { iso8601_errc::input_too_long, iso8601_component::timezone_offset,
+                 iso8601_max_parse_length };
+
+    const std::size_t length{ date.size() };
+
+    // helper lambdas
+    auto position = [&length, &date]() { return length - date.size(); };
+
+    auto is_digit = [](const char ch) { return ch >= '0' && ch <= '9'; };
+
+    auto integer = [&is_digit, &date](int digits, unsigned int& number) {
+        number = 0;
+        while (digits-- > 0)
         {
+            if (date.empty())
+                return iso8601_errc::missing_digit;
+            if (!is_digit(date[0]))
+                return iso8601_errc::not_a_digit;
+            number = number * 10 + (date[0] - '0');
             date.remove_prefix(1);
-            while (!date.empty() && is_digit(date[0]))
-            {
-                number = number * 10 + to_digit(date[0]);
-                date.remove_prefix(1);
-                divisor *= 10;
-            }
         }
-        return std::make_pair(number, divisor);
+        return iso8601_errc::ok;
     };
 
-    auto is_positive_sign = [&date]() {
+    auto fraction = [&is_digit, &date, rounding](const fraction_scale& scale,
+                                                 unsigned long long&   decimals,
+                                                 fraction_residue&     residue) {
+        std::size_t digits{ 0 };
+        while (digits < date.size() && is_digit(date[digits]))
+            ++digits;
+        convert_fraction(date.substr(0, digits), scale, rounding, decimals, residue);
+        date.remove_prefix(digits);
+    };
+
+    auto sign = [&date](bool& positive) {
         assert(!date.empty());
         if (date[0] == '+')
         {
             date.remove_prefix(1);
-            return true;
+            positive = true;
+            return iso8601_errc::ok;
         }
         if (date[0] == '-')
         {
             date.remove_prefix(1);
-            return false;
+            positive = false;
+            return iso8601_errc::ok;
         }
         // utf-8 minus sign
         if (date.size() >= 3 && date.substr(0, 3) == "\xe2\x88\x92")
         {
             date.remove_prefix(3);
-            return false;
+            positive = false;
+            return iso8601_errc::ok;
         }
-        throw std::runtime_error("Invalid time offset sign");
+        return iso8601_errc::invalid_offset_sign;
     };
-
-    struct timezone_offset_t
-    {
-        bool         positive;
-        unsigned int hours;
-        unsigned int minutes;
-
-        int to_minutes() const noexcept
-        {
-            int result = hours * 60 + minutes;
-            return positive ? result : -result;
-        }
-        // valid time zone offsets: https://en.wikipedia.org/wiki/List_of_UTC_time_offsets
-        bool ok() const noexcept
-        {
-            switch (minutes)
-            {
-            case 0:
-                return hours <= 12 || (positive && hours <= 14);
-            case 30:
-                if (positive)
-                    switch (hours)
-                    {
-                    case 3:
-                    case 4:
-                    case 5:
-                    case 6:
-                    case 9:
-                    case 10:
-                        return true;
-                    }
-                else
-                    switch (hours)
-                    {
-                    case 3:
-                    case 9:
-                        return true;
-                    }
-                return false;
-            case 45:
-                if (positive)
-                    switch (hours)
-                    {
-                    case 5:
-                    case 8:
-                    case 12:
-                        return true;
-                    }
-                return false;
-            default:
-                return false;
-            }
-        }
-    };
-
     // here starts the actual code!
-    union
-    {
-        unsigned int date_components[3];
-        struct
-        {
-            int          year;
-            unsigned int month;
-            unsigned int day;
-        } d{ 0, 1, 1 };
-    };
+    int& parsed{ fields.parsed };
 
-    union
+    // separators are either used throughout (extended format) or omitted (basic format), which
+    // is known once the first one is expected
+    enum class separators
     {
-        unsigned int time_components[3];
-        struct
-        {
-            unsigned int hours;
-            unsigned int minutes;
-            unsigned int seconds;
-        } t{ 0, 0, 0 };
+        unknown,
+        extended,
+        basic,
     };
+    separators layout{ separators::unknown };
 
-    unsigned long long decimals{ 0 };
-    timezone_offset_t  offset{ true, 0, 0 };
-
-    int parsed{ 0 };
-
-    boost::tribool has_separator{ boost::indeterminate };
+    // error reporting: nothing is tracked on the success path
+    auto fail = [&position](iso8601_errc code, iso8601_component component) {
+        return iso8601_error{ code, component, position() };
+    };
 
-    auto process_separator = [&date, &has_separator](char separator) {
-        if (indeterminate(has_separator))
-            has_separator = date[0] == separator;
-        else if (has_separator != (date[0] == separator))
-            throw std::runtime_error("Separator missing");
-        if (has_separator)
+    auto process_separator = [&date, &layout](char separator) {
+        const separators found{ date[0] == separator ? separators::extended : separators::basic };
+        if (layout == separators::unknown)
+            layout = found;
+        else if (layout != found)
+            return iso8601_errc::separator_missing;
+        if (layout == separators::extended)
             date.remove_prefix(1);
+        return iso8601_errc::ok;
     };
 
     auto is_end_of_date = [&date]() { return date.empty() || date[0] == 'T'; };
@@ -190,27 +858,31 @@ parse_iso8601datetime(std::string_view date,
     int digits{ 4 };
     for (int i = 0; i < 3; ++i)
     {
-        date_components[i] = integer(digits);
+        if (auto error = integer(digits, fields.date_components[i]); error != iso8601_errc::ok)
+            return fail(error, static_cast<iso8601_component>(i));
 
         if (is_end_of_date())
             break;
 
         ++parsed;
         digits = 2;
-        process_separator('-');
+        if (auto error = process_separator('-'); error != iso8601_errc::ok)
+            return fail(error, static_cast<iso8601_component>(i + 1));
     }
 
     if (!date.empty())
     {
         if (parsed < 2)
-            throw std::runtime_error("Incomplete date");
+            return fail(iso8601_errc::incomplete_date, static_cast<iso8601_component>(parsed + 1));
         if (date[0] != 'T')
-            throw std::runtime_error("Delimiter 'T' is missing after date");
+            return fail(iso8601_errc::missing_date_time_delimiter, iso8601_component::hours);
         date.remove_prefix(1);
 
-        constexpr unsigned long long multipliers[]{ Duration::period::den * 60 * 60,
-                                                    Duration::period::den * 60,
-                                                    Duration::period::den };
+        constexpr fraction_scale fraction_scales[]{
+            make_fraction_scale(Duration::period::den * 60 * 60),
+            make_fraction_scale(Duration::period::den * 60),
+            make_fraction_scale(Duration::period::den)
+        };
 
         auto is_end_of_time = [&date]() {
             return date.empty() || date[0] == 'Z' || date[0] == '+' || date[0] == '-' ||
@@ -219,80 +891,671 @@ parse_iso8601datetime(std::string_view date,
         // read hours, minutes, seconds
         for (int i = 0; i < 3; ++i)
         {
-            auto [digits, divisor] = decimal(2);
-            time_components[i]     = static_cast<unsigned int>(digits / divisor);
+            if (auto error = integer(2, fields.time_components[i]); error != iso8601_errc::ok)
+                return fail(error, static_cast<iso8601_component>(i + 3));
             ++parsed;
-            if (divisor != 1)
-                decimals = digits % divisor * multipliers[i] / divisor;
+            if (!date.empty() && (date[0] == '.' || date[0] == ','))
+            {
+                date.remove_prefix(1);
+                fraction(fraction_scales[i], fields.decimals, fields.residue);
+            }
 
             if (is_end_of_time())
                 break;
 
-            process_separator(':');
+            if (auto error = process_separator(':'); error != iso8601_errc::ok)
+                return fail(error, static_cast<iso8601_component>(i + 4));
         }
 
         if (!date.empty())
         {
+            fields.offset_position = position();
             if (date[0] == 'Z')
                 date.remove_prefix(1);
             else
             {
                 // read timezone offset
-                offset.positive = is_positive_sign();
-                offset.hours    = integer(2);
+                if (auto error = sign(fields.offset.positive); error != iso8601_errc::ok)
+                    return fail(error, iso8601_component::timezone_offset);
+                if (auto error = integer(2, fields.offset.hours); error != iso8601_errc::ok)
+                    return fail(error, iso8601_component::timezone_offset);
 
                 if (!date.empty())
                 {
                     if (date[0] != ':')
-                        throw std::runtime_error("Missing time offset separator");
+                        return fail(iso8601_errc::missing_offset_separator,
+                                    iso8601_component::timezone_offset);
                     date.remove_prefix(1);
 
-                    offset.minutes = integer(2);
+                    if (auto error = integer(2, fields.offset.minutes); error != iso8601_errc::ok)
+                        return fail(error, iso8601_component::timezone_offset);
                 }
             }
             if (!date.empty())
-                throw std::runtime_error("Invalid termination");
+                return fail(iso8601_errc::invalid_termination, iso8601_component::timezone_offset);
         }
         assert(date.empty());
     }
 
-    // perform checks
-    if (parsed < static_cast<int>(required))
+    fields.extended = layout == separators::extended;
+    return {};
+}
+
+// General parser handling all supported layouts, usable in constant expressions
+template <typename Duration>
+constexpr iso8601_error
+parse_iso8601_general(std::string_view date, time_point<Duration>& result,
+                      iso8601_required required,
+                      iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    iso8601_fields fields;
+    if (auto error = scan_iso8601_general<Duration>(date, fields, rounding))
+        return error;
+    return convert_fields(fields, date.size(), result, required, rounding);
+}
+
+// Table-driven engine parsing the same grammar as parse_iso8601_general. Characters are mapped to
+// classes and a state machine built at compile time consumes two characters per step, so the
+// only data-dependent branch on the success path is the loop exit and its cost does not depend on
+// how layouts are mixed. Transitions record positions of components instead of accumulating their
+// values; digits are converted and checked after the string has been accepted, in the same way as
+// by the general parser.
+
+// character classes, end is the class of the position past the last character
+enum class table_class : unsigned char
+{
+    digit,
+    hyphen,
+    colon,
+    designator,
+    zulu,
+    plus,
+    decimal_sign,
+    // bytes of utf-8 minus sign
+    minus_0,
+    minus_1,
+    minus_2,
+    other,
+    end,
+};
+
+// rows are padded to a power of two
+constexpr std::size_t table_column_count{ 16 };
+
+struct table_classes
+{
+    table_class data[256];
+
+    constexpr table_classes()
+        : data{}
     {
-        if (parsed < static_cast<int>(iso8601_required::YYYYMMDD))
-            throw std::runtime_error("Incomplete date");
-        throw std::runtime_error("Incomplete time");
+        for (auto& cls : data)
+            cls = table_class::other;
+        for (int ch = '0'; ch <= '9'; ++ch)
+            data[ch] = table_class::digit;
+        data[static_cast<unsigned char>('-')]    = table_class::hyphen;
+        data[static_cast<unsigned char>(':')]    = table_class::colon;
+        data[static_cast<unsigned char>('T')]    = table_class::designator;
+        data[static_cast<unsigned char>('Z')]    = table_class::zulu;
+        data[static_cast<unsigned char>('+')]    = table_class::plus;
+        data[static_cast<unsigned char>('.')]    = table_class::decimal_sign;
+        data[static_cast<unsigned char>(',')]    = table_class::decimal_sign;
+        data[static_cast<unsigned char>('\xe2')] = table_class::minus_0;
+        data[static_cast<unsigned char>('\x88')] = table_class::minus_1;
+        data[static_cast<unsigned char>('\x92')] = table_class::minus_2;
     }
+};
 
-    using date::day;
-    using date::month;
-    using date::year;
-    using date::year_month_day;
+inline constexpr table_classes table_character_classes{};
 
-    const year_month_day& ymd{ year{ d.year }, month{ d.month }, day{ d.day } };
-    if (!ymd.ok())
-        throw std::runtime_error("Invalid date");
+// recorded positions, one past the character, 0 if not reached
+enum class table_mark : unsigned char
+{
+    // first digits of components following the year
+    month,
+    day,
+    hours,
+    minutes,
+    seconds,
+    offset_hours,
+    offset_minutes,
+    // separator between date and 'T', counted as a component by the general parser
+    date_extra,
+    // separator after year
+    extended,
+    // first and one past the last fraction digit of hours, minutes and seconds
+    hours_fraction_begin,
+    minutes_fraction_begin,
+    seconds_fraction_begin,
+    hours_fraction_end,
+    minutes_fraction_end,
+    seconds_fraction_end,
+    // timezone designator, also where an invalid offset sign has been found
+    offset,
+    none,
+};
 
-    // 60 seconds is used to denote an added leap second
-    // "24:00" may be used for midnight
-    if (t.hours > 24 || (t.hours == 24 && (t.minutes != 0 || t.seconds != 0 || decimals != 0)) ||
-        t.minutes > 59 || t.seconds > 60 || (t.seconds == 60 && decimals != 0))
-        throw std::runtime_error("Invalid time");
+struct table_transition
+{
+    unsigned char next;
+    table_mark    mark;
+};
 
-    if (!offset.ok())
-        throw std::runtime_error("Invalid timezone offset");
+struct parser_table
+{
+    // states of hours, minutes and seconds in one format and of offset with one sign
+    static constexpr int time_state_count{ 4 * 3 };
+    static constexpr int offset_state_count{ 6 };
+    static constexpr int component_count{ 7 };
 
-    using date::sys_days;
+    enum state : unsigned char
+    {
+        year_0,
+        year_1,
+        year_2,
+        year_3,
+        year_4,
+        month_0,
+        month_1,
+        month_2,
+        month_1_basic,
+        month_2_basic,
+        day_0,
+        day_1,
+        day_2,
+        day_1_basic,
+        day_2_basic,
+        date_extra,
+        // hours, minutes and seconds in extended format followed by the same in basic format
+        time_0,
+        time_extra = time_0 + 2 * time_state_count,
+        zone_end,
+        // after the first and the second byte of utf-8 minus sign
+        minus_1,
+        minus_2,
+        // positive offset followed by negative offset
+        offset_0,
+        // states below have no outgoing transitions
+        accept = offset_0 + 2 * offset_state_count,
+        accept_negative,
+        // one for each error code and component
+        error_0,
+    };
 
-    constexpr sys_days ref_tp{ year{ 1970 } / month{ 1 } / day{ 1 } };
+    static constexpr unsigned char error(iso8601_errc code, iso8601_component component) noexcept
+    {
+        return static_cast<unsigned char>(error_0 + static_cast<int>(code) * component_count +
+                                          static_cast<int>(component));
+    }
 
-    long long days = (sys_days{ ymd } - ref_tp).count();
-    auto      count =
-        ((((days * 24 + t.hours) * 60 + t.minutes - offset.to_minutes()) * 60 + t.seconds) *
-             Duration::period::den +
-         decimals) /
-        Duration::period::num;
-    return time_point<Duration>{ Duration{ count } };
+    // Hours, minutes and seconds use 4 states each: before the first digit, after the first
+    // digit, after the second digit and inside fraction.
+    static constexpr unsigned char time_state(int component, int index, bool extended) noexcept
+    {
+        return static_cast<unsigned char>(time_0 + (extended ? 0 : time_state_count) +
+                                          4 * component + index);
+    }
+
+    static constexpr unsigned char offset_state(int index, bool negative) noexcept
+    {
+        return static_cast<unsigned char>(offset_0 + (negative ? offset_state_count : 0) + index);
+    }
+
+    table_transition transitions[accept][table_column_count];
+
+    constexpr parser_table()
+        : transitions{}
+    {
+        using component = iso8601_component;
+        using errc      = iso8601_errc;
+
+        auto set = [this](int state, table_class cls, unsigned char next,
+                          table_mark mark = table_mark::none) {
+            transitions[state][static_cast<std::size_t>(cls)] = { next, mark };
+        };
+        auto fill = [this](int state, unsigned char next, table_mark mark = table_mark::none) {
+            for (auto& transition : transitions[state])
+                transition = { next, mark };
+        };
+        // all classes fail with not_a_digit except end with missing_digit, digit is set by caller
+        auto expect_digit = [&fill, &set](int state, component failing) {
+            fill(state, error(errc::not_a_digit, failing));
+            set(state, table_class::end, error(errc::missing_digit, failing));
+        };
+        // timezone designator following time or time separator
+        auto zone = [&set](int state) {
+            set(state, table_class::zulu, zone_end, table_mark::offset);
+            set(state, table_class::plus, offset_state(0, false), table_mark::offset);
+            set(state, table_class::hyphen, offset_state(0, true), table_mark::offset);
+            set(state, table_class::minus_0, minus_1, table_mark::offset);
+        };
+        const unsigned char invalid_sign{ error(errc::invalid_offset_sign,
+                                                component::timezone_offset) };
+
+        // year
+        for (int state = year_0; state < year_4; ++state)
+        {
+            expect_digit(state, component::year);
+            set(state, table_class::digit, static_cast<unsigned char>(state + 1));
+        }
+        expect_digit(year_4, component::month);
+        set(year_4, table_class::end, accept);
+        set(year_4, table_class::designator, error(errc::incomplete_date, component::month));
+        set(year_4, table_class::hyphen, month_0, table_mark::extended);
+        set(year_4, table_class::digit, month_1_basic, table_mark::month);
+
+        // month
+        expect_digit(month_0, component::month);
+        set(month_0, table_class::digit, month_1, table_mark::month);
+        expect_digit(month_1, component::month);
+        set(month_1, table_class::digit, month_2);
+        expect_digit(month_1_basic, component::month);
+        set(month_1_basic, table_class::digit, month_2_basic);
+
+        fill(month_2, error(errc::separator_missing, component::day));
+        set(month_2, table_class::hyphen, day_0);
+        expect_digit(month_2_basic, component::day);
+        set(month_2_basic, table_class::hyphen, error(errc::separator_missing, component::day));
+        set(month_2_basic, table_class::digit, day_1_basic, table_mark::day);
+        for (int state : { month_2, month_2_basic })
+        {
+            set(state, table_class::end, accept);
+            set(state, table_class::designator, error(errc::incomplete_date, component::day));
+        }
+
+        // day
+        expect_digit(day_0, component::day);
+        set(day_0, table_class::digit, day_1, table_mark::day);
+        expect_digit(day_1, component::day);
+        set(day_1, table_class::digit, day_2);
+        expect_digit(day_1_basic, component::day);
+        set(day_1_basic, table_class::digit, day_2_basic);
+
+        fill(day_2, error(errc::separator_missing, component::hours));
+        set(day_2, table_class::hyphen, date_extra, table_mark::date_extra);
+        fill(day_2_basic, error(errc::missing_date_time_delimiter, component::hours));
+        set(day_2_basic, table_class::hyphen, error(errc::separator_missing, component::hours));
+        fill(date_extra, error(errc::missing_date_time_delimiter, component::hours));
+        set(day_2, table_class::designator, time_state(0, 0, true));
+        set(day_2_basic, table_class::designator, time_state(0, 0, false));
+        set(date_extra, table_class::designator, time_state(0, 0, true));
+        for (int state : { day_2, day_2_basic, date_extra })
+            set(state, table_class::end, accept);
+
+        // hours, minutes, seconds
+        constexpr table_mark time_marks[]{ table_mark::hours, table_mark::minutes,
+                                           table_mark::seconds };
+        constexpr table_mark fraction_begin_marks[]{ table_mark::hours_fraction_begin,
+                                                     table_mark::minutes_fraction_begin,
+                                                     table_mark::seconds_fraction_begin };
+        constexpr table_mark fraction_end_marks[]{ table_mark::hours_fraction_end,
+                                                   table_mark::minutes_fraction_end,
+                                                   table_mark::seconds_fraction_end };
+        for (bool extended : { true, false })
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                const auto current{ static_cast<component>(i + 3) };
+                const auto following{ static_cast<component>(i + 4) };
+                const int  first{ time_state(i, 0, extended) };
+                const int  second{ time_state(i, 1, extended) };
+                const int  complete{ time_state(i, 2, extended) };
+                const int  fraction{ time_state(i, 3, extended) };
+
+                expect_digit(first, current);
+                set(first, table_class::digit, static_cast<unsigned char>(second), time_marks[i]);
+                expect_digit(second, current);
+                set(second, table_class::digit, static_cast<unsigned char>(complete));
+
+                // after the number and after its fraction
+                for (int state : { complete, fraction })
+                {
+                    if (extended)
+                    {
+                        fill(state, error(errc::separator_missing, following));
+                        set(state, table_class::colon,
+                            i < 2 ? time_state(i + 1, 0, true)
+                                  : static_cast<unsigned char>(time_extra));
+                    }
+                    else if (i < 2)
+                    {
+                        expect_digit(state, following);
+                        set(state, table_class::colon, error(errc::separator_missing, following));
+                        set(state, table_class::digit, time_state(i + 1, 1, false),
+                            time_marks[i + 1]);
+                    }
+                    else
+                    {
+                        fill(state, invalid_sign, table_mark::offset);
+                        set(state, table_class::colon, error(errc::separator_missing, following));
+                    }
+                    set(state, table_class::end, accept);
+                    zone(state);
+                }
+                set(complete, table_class::decimal_sign, static_cast<unsigned char>(fraction),
+                    fraction_begin_marks[i]);
+                set(fraction, table_class::digit, static_cast<unsigned char>(fraction),
+                    fraction_end_marks[i]);
+            }
+        }
+        fill(time_extra, invalid_sign, table_mark::offset);
+        set(time_extra, table_class::end, accept);
+        zone(time_extra);
+
+        // timezone designator
+        fill(zone_end, error(errc::invalid_termination, component::timezone_offset));
+        set(zone_end, table_class::end, accept);
+        fill(minus_1, invalid_sign);
+        set(minus_1, table_class::minus_1, minus_2);
+        fill(minus_2, invalid_sign);
+        set(minus_2, table_class::minus_2, offset_state(0, true));
+        for (bool negative : { false, true })
+        {
+            const unsigned char done{ negative ? accept_negative : accept };
+            for (int state : { 0, 1, 3, 4 })
+            {
+                expect_digit(offset_state(state, negative), component::timezone_offset);
+                set(offset_state(state, negative), table_class::digit,
+                    offset_state(state + 1, negative),
+                    state == 0   ? table_mark::offset_hours
+                    : state == 3 ? table_mark::offset_minutes
+                                 : table_mark::none);
+            }
+            fill(offset_state(2, negative),
+                 error(errc::missing_offset_separator, component::timezone_offset));
+            set(offset_state(2, negative), table_class::colon, offset_state(3, negative));
+            set(offset_state(2, negative), table_class::end, done);
+            fill(offset_state(5, negative),
+                 error(errc::invalid_termination, component::timezone_offset));
+            set(offset_state(5, negative), table_class::end, done);
+        }
+    }
+};
+
+inline constexpr parser_table iso8601_parser_table{};
+
+constexpr std::size_t table_class_count{ static_cast<std::size_t>(table_class::end) + 1 };
+constexpr std::size_t table_pair_count{ table_class_count * table_class_count };
+
+struct table_pair_transition
+{
+    // next state multiplied by table_pair_count, so that the step does not need a multiplication
+    std::uint16_t next;
+    table_mark    first_mark;
+    table_mark    second_mark;
+};
+
+// transitions of parser_table composed for each pair of characters
+struct parser_pair_table
+{
+    table_pair_transition transitions[parser_table::accept * table_pair_count];
+
+    constexpr parser_pair_table(const parser_table& single)
+        : transitions{}
+    {
+        for (std::size_t state = 0; state < parser_table::accept; ++state)
+        {
+            for (std::size_t first = 0; first < table_class_count; ++first)
+            {
+                const table_transition step{ single.transitions[state][first] };
+                for (std::size_t second = 0; second < table_class_count; ++second)
+                {
+                    auto& transition{
+                        transitions[state * table_pair_count + first * table_class_count + second]
+                    };
+                    const table_transition next{ step.next >= parser_table::accept
+                                                     ? step
+                                                     : single.transitions[step.next][second] };
+                    transition = { static_cast<std::uint16_t>(next.next * table_pair_count),
+                                   step.mark,
+                                   step.next >= parser_table::accept ? table_mark::none
+                                                                     : next.mark };
+                }
+            }
+        }
+    }
+};
+
+inline constexpr parser_pair_table iso8601_pair_table{ iso8601_parser_table };
+
+template <typename Duration>
+constexpr iso8601_error scan_iso8601_table(std::string_view date, iso8601_fields& fields,
+                                           iso8601_rounding rounding) noexcept
+{
+    using table = parser_table;
+
+    if (date.size() > iso8601_max_parse_length)
+        return { iso8601_errc::input_too_long, iso8601_component::timezone_offset,
+                 iso8601_max_parse_length };
+
+    const std::size_t length{ date.size() };
+
+    // one more entry for table_mark::none, which is written unconditionally; positions fit into
+    // a byte as longer strings have been rejected
+    unsigned char marks[static_cast<std::size_t>(table_mark::none) + 1]{};
+
+    auto cls = [&date](std::size_t position) {
+        return static_cast<std::size_t>(
+            table_character_classes.data[static_cast<unsigned char>(date[position])]);
+    };
+
+    // two characters per step halve the length of the dependency chain through state
+    constexpr std::size_t accept_row{ table::accept * table_pair_count };
+    std::size_t           row{ table::year_0 * table_pair_count };
+    std::size_t           previous{ row };
+    std::size_t           position{ 0 };
+    for (; position + 1 < length; position += 2)
+    {
+        const table_pair_transition transition{
+            iso8601_pair_table
+                .transitions[row + cls(position) * table_class_count + cls(position + 1)]
+        };
+        marks[static_cast<std::size_t>(transition.first_mark)] =
+            static_cast<unsigned char>(position + 1);
+        marks[static_cast<std::size_t>(transition.second_mark)] =
+            static_cast<unsigned char>(position + 2);
+        previous = row;
+        row      = transition.next;
+        if (row >= accept_row)
+            break;
+    }
+
+    std::size_t state{ row / table_pair_count };
+    if (row >= accept_row)
+    {
+        // failed at the first or at the second character of the pair
+        if (iso8601_parser_table.transitions[previous / table_pair_count][cls(position)].next <
+            table::accept)
+            ++position;
+    }
+    else
+    {
+        if (position < length)
+        {
+            const table_transition transition{
+                iso8601_parser_table.transitions[state][cls(position)]
+            };
+            marks[static_cast<std::size_t>(transition.mark)] =
+                static_cast<unsigned char>(position + 1);
+            state = transition.next;
+            if (state < table::accept)
+                ++position;
+        }
+        if (position == length)
+            state =
+                iso8601_parser_table.transitions[state][static_cast<std::size_t>(table_class::end)]
+                    .next;
+    }
+
+    auto mark = [&marks](table_mark m) {
+        return static_cast<std::size_t>(marks[static_cast<std::size_t>(m)]);
+    };
+
+    if (state >= table::error_0)
+    {
+        const auto code{ static_cast<iso8601_errc>((state - table::error_0) /
+                                                   table::component_count) };
+        const auto component{ static_cast<iso8601_component>((state - table::error_0) %
+                                                             table::component_count) };
+        // sign is checked once the whole utf-8 minus sign has been read
+        return { code, component,
+                 code == iso8601_errc::invalid_offset_sign ? mark(table_mark::offset) - 1
+                                                           : position };
+    }
+
+    // two digits following the recorded position of the first one, 0 if not reached
+    auto number = [&date, &mark](table_mark m) {
+        const std::size_t begin{ mark(m) };
+        return begin == 0 ? 0u
+                          : static_cast<unsigned int>(date[begin - 1] - '0') * 10 +
+                                static_cast<unsigned int>(date[begin] - '0');
+    };
+
+    fields.date_components[0] = static_cast<unsigned int>(date[0] - '0') * 1000 +
+                                static_cast<unsigned int>(date[1] - '0') * 100 +
+                                static_cast<unsigned int>(date[2] - '0') * 10 +
+                                static_cast<unsigned int>(date[3] - '0');
+    fields.date_components[1] = mark(table_mark::month) != 0 ? number(table_mark::month) : 1;
+    fields.date_components[2] = mark(table_mark::day) != 0 ? number(table_mark::day) : 1;
+    fields.time_components[0] = number(table_mark::hours);
+    fields.time_components[1] = number(table_mark::minutes);
+    fields.time_components[2] = number(table_mark::seconds);
+    fields.offset             = { state != table::accept_negative, number(table_mark::offset_hours),
+                                  number(table_mark::offset_minutes) };
+    fields.parsed = (mark(table_mark::month) != 0) + (mark(table_mark::day) != 0) +
+                    (mark(table_mark::date_extra) != 0) + (mark(table_mark::hours) != 0) +
+                    (mark(table_mark::minutes) != 0) + (mark(table_mark::seconds) != 0);
+    fields.extended        = mark(table_mark::extended) != 0;
+    fields.offset_position = mark(table_mark::offset) - (mark(table_mark::offset) != 0);
+
+    // as in the general parser, the last non-empty fraction determines decimals
+    constexpr fraction_scale fraction_scales[]{
+        make_fraction_scale(Duration::period::den * 60 * 60),
+        make_fraction_scale(Duration::period::den * 60), make_fraction_scale(Duration::period::den)
+    };
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        const std::size_t begin{ mark(static_cast<table_mark>(
+            static_cast<std::size_t>(table_mark::hours_fraction_begin) + i)) };
+        const std::size_t end{ mark(
+            static_cast<table_mark>(static_cast<std::size_t>(table_mark::hours_fraction_end) + i)) };
+        if (end > begin)
+            convert_fraction(date.substr(begin, end - begin), fraction_scales[i], rounding,
+                             fields.decimals, fields.residue);
+    }
+    return {};
+}
+
+template <typename Duration>
+constexpr iso8601_error
+parse_iso8601_table(std::string_view date, time_point<Duration>& result, iso8601_required required,
+                    iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    iso8601_fields fields;
+    if (auto error = scan_iso8601_table<Duration>(date, fields, rounding))
+        return error;
+    return convert_fields(fields, date.size(), result, required, rounding);
+}
+
+// Engine used for layouts not handled by the canonical fast path, the table-driven one if
+// ISO8601_TABLE_PARSER is defined.
+template <typename Duration>
+constexpr iso8601_error
+parse_iso8601_engine(std::string_view date, time_point<Duration>& result, iso8601_required required,
+                     iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+#if defined(ISO8601_TABLE_PARSER)
+    return parse_iso8601_table(date, result, required, rounding);
+#else
+    return parse_iso8601_general(date, result, required, rounding);
+#endif
+}
+
+// Scanner of the engine selected as above
+template <typename Duration>
+constexpr iso8601_error scan_iso8601_engine(std::string_view date, iso8601_fields& fields,
+                                            iso8601_rounding rounding) noexcept
+{
+#if defined(ISO8601_TABLE_PARSER)
+    return scan_iso8601_table<Duration>(date, fields, rounding);
+#else
+    return scan_iso8601_general<Duration>(date, fields, rounding);
+#endif
 }
 
+} // namespace detail
+
+// Non-throwing variant: on success stores the parsed value into result and returns an empty
+// iso8601_error, otherwise leaves result untouched and returns the error details.
+template <typename Duration = std::chrono::seconds>
+inline iso8601_error
+try_parse_iso8601datetime(std::string_view date, time_point<Duration>& result,
+                          iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                          iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    if (detail::parse_iso8601_canonical(date, result, rounding))
+        return {};
+    return detail::parse_iso8601_engine(date, result, required, rounding);
+}
+
+// Checks whether date would be accepted by try_parse_iso8601datetime with the same arguments:
+// the same layouts and range checks apply, but no time point is computed. Duration matters only
+// for the leap second and midnight checks, which reject any non-zero fraction it can represent.
+template <typename Duration = std::chrono::seconds>
+inline bool is_valid_iso8601(std::string_view date,
+                             iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    if (detail::is_valid_iso8601_canonical<Duration>(date))
+        return true;
+    detail::iso8601_fields fields;
+    return !detail::scan_iso8601_engine<Duration>(date, fields, iso8601_rounding::truncate) &&
+           !detail::check_fields(fields, date.size(), required);
+}
+
+template <typename Duration = std::chrono::seconds>
+inline time_point<Duration>
+parse_iso8601datetime(std::string_view date,
+                      iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                      iso8601_rounding rounding = iso8601_rounding::truncate)
+{
+    time_point<Duration> result;
+    if (auto error = try_parse_iso8601datetime(date, result, required, rounding))
+        throw iso8601_parse_error(error);
+    return result;
+}
+
+// Variant usable in constant expressions. It runs only the general parser, because the canonical
+// fast path relies on memcpy; when evaluated at compile time, an invalid string is reported as a
+// compilation error.
+template <typename Duration = std::chrono::seconds>
+constexpr time_point<Duration>
+parse_iso8601datetime_constexpr(std::string_view date,
+                                iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                                iso8601_rounding rounding = iso8601_rounding::truncate)
+{
+    time_point<Duration> result{};
+    if (auto error = detail::parse_iso8601_general(date, result, required, rounding))
+        throw iso8601_parse_error(error);
+    return result;
+}
+
+inline namespace literals {
+
+// "2020-08-13T23:10:13.123Z"_iso8601 accepts any layout supported by parse_iso8601datetime,
+// including date only. Microseconds keep typical fractions exact for years 0 to 9999. With C++20
+// the literal is always evaluated at compile time.
+#if defined(__cpp_consteval)
+consteval
+#else
+constexpr
+#endif
+    time_point<std::chrono::microseconds>
+    operator""_iso8601(const char* date, std::size_t length)
+{
+    return parse_iso8601datetime_constexpr<std::chrono::microseconds>({ date, length },
+                                                                      iso8601_required::YYYY);
+}
+
+} // namespace literals
+
 } // namespace core::time
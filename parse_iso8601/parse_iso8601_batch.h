@@ -0,0 +1,78 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace core::time {
+
+// Parses count strings into out. Bit i % 8 of valid[i / 8] is set if dates[i] has been parsed
+// successfully, otherwise out[i] is set to the epoch; valid must hold (count + 7) / 8 bytes.
+// Returns the number of successfully parsed strings.
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+parse_iso8601datetimes(const std::string_view* dates, std::size_t count, time_point<Duration>* out,
+                       std::uint8_t* valid,
+                       iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    // first pass runs only the canonical fast path, so that its branches stay predictable on
+    // uniform input and validity bits are collected without memory round trips
+    for (std::size_t i = 0; i < count; i += 8)
+    {
+        const std::size_t n{ std::min<std::size_t>(8, count - i) };
+        unsigned int      bits{ 0 };
+        for (std::size_t j = 0; j < n; ++j)
+            bits |= static_cast<unsigned int>(
+                        detail::parse_iso8601_canonical(dates[i + j], out[i + j]))
+                    << j;
+        valid[i / 8] = static_cast<std::uint8_t>(bits);
+    }
+
+    // second pass passes remaining strings to the general parser
+    std::size_t parsed{ 0 };
+    for (std::size_t i = 0; i < count; i += 8)
+    {
+        const std::size_t n{ std::min<std::size_t>(8, count - i) };
+        const unsigned int all{ (1u << n) - 1 };
+        unsigned int       bits{ valid[i / 8] };
+        if (bits != all)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                if (bits & (1u << j))
+                    continue;
+                if (detail::parse_iso8601_engine(dates[i + j], out[i + j], required))
+                    out[i + j] = time_point<Duration>{};
+                else
+                    bits |= 1u << j;
+            }
+            valid[i / 8] = static_cast<std::uint8_t>(bits);
+        }
+        for (; bits != 0; bits &= bits - 1)
+            ++parsed;
+    }
+    return parsed;
+}
+
+#if defined(__cpp_lib_span)
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+parse_iso8601datetimes(std::span<const std::string_view> dates, std::span<time_point<Duration>> out,
+                       std::span<std::uint8_t> valid,
+                       iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    assert(out.size() >= dates.size());
+    assert(valid.size() >= (dates.size() + 7) / 8);
+    return parse_iso8601datetimes(dates.data(), dates.size(), out.data(), valid.data(), required);
+}
+#endif
+
+} // namespace core::time
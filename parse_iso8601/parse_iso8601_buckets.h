@@ -0,0 +1,200 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <string_view>
+
+#if __has_include(<span>)
+#include <span>
+#endif
+
+namespace core::time {
+
+// Buckets of equal width starting at origin; bucket i covers [origin + i * width,
+// origin + (i + 1) * width), so timestamps before origin fall into negative buckets.
+template <typename Duration = std::chrono::seconds>
+struct iso8601_buckets
+{
+    time_point<Duration> origin;
+    Duration             width;
+};
+
+namespace detail {
+
+// quotient rounded towards negative infinity, divisor must be positive
+constexpr long long floor_divide(long long dividend, long long divisor) noexcept
+{
+    const long long quotient{ dividend / divisor };
+    return quotient - (dividend % divisor < 0);
+}
+
+// Buckets converted to the resolution used for parsing. Fractions of a second cannot move a
+// timestamp across a bucket boundary if both origin and width are whole seconds, so parsing then
+// only validates the fraction digits.
+template <typename Duration>
+struct bucket_parser
+{
+    bool      whole_seconds;
+    long long origin;
+    long long width;
+
+    explicit bucket_parser(const iso8601_buckets<Duration>& buckets) noexcept
+    {
+        assert(buckets.width > Duration::zero());
+        using std::chrono::seconds;
+        if constexpr (std::ratio_less_v<typename Duration::period, std::ratio<1>>)
+        {
+            whole_seconds = buckets.origin.time_since_epoch() % seconds{ 1 } == Duration::zero() &&
+                            buckets.width % seconds{ 1 } == Duration::zero();
+            if (whole_seconds)
+            {
+                origin = std::chrono::duration_cast<seconds>(buckets.origin.time_since_epoch())
+                             .count();
+                width = std::chrono::duration_cast<seconds>(buckets.width).count();
+                return;
+            }
+        }
+        whole_seconds = false;
+        origin        = buckets.origin.time_since_epoch().count();
+        width         = buckets.width.count();
+    }
+
+    iso8601_error operator()(std::string_view date, long long& bucket,
+                             iso8601_required required) const noexcept
+    {
+        if (!whole_seconds)
+        {
+            time_point<Duration> result;
+            if (auto error = try_parse_iso8601datetime(date, result, required))
+                return error;
+            bucket = floor_divide(result.time_since_epoch().count() - origin, width);
+            return {};
+        }
+
+        time_point<std::chrono::seconds> result;
+        if (auto error = try_parse_iso8601datetime(date, result, required))
+            return error;
+        // a leap second or 24:00 with a fraction representable in Duration is invalid; both end
+        // on a whole minute, so only then the string is parsed again at full resolution
+        if (result.time_since_epoch().count() % 60 == 0)
+        {
+            time_point<Duration> exact;
+            if (auto error = try_parse_iso8601datetime(date, exact, required))
+                return error;
+        }
+        bucket = floor_divide(result.time_since_epoch().count() - origin, width);
+        return {};
+    }
+};
+
+} // namespace detail
+
+// Parses date and stores the index of the bucket it falls into, i.e.
+// floor((parse_iso8601datetime<Duration>(date) - origin) / width), without a time point for
+// the caller to convert. On failure bucket is left untouched.
+template <typename Duration = std::chrono::seconds>
+inline iso8601_error
+try_parse_iso8601bucket(std::string_view date, const iso8601_buckets<Duration>& buckets,
+                        long long& bucket,
+                        iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    return detail::bucket_parser<Duration>{ buckets }(date, bucket, required);
+}
+
+template <typename Duration = std::chrono::seconds>
+inline long long parse_iso8601bucket(std::string_view                  date,
+                                     const iso8601_buckets<Duration>& buckets,
+                                     iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+{
+    long long bucket;
+    if (auto error = try_parse_iso8601bucket(date, buckets, bucket, required))
+        throw iso8601_parse_error(error);
+    return bucket;
+}
+
+// Batch form: stores bucket indices of count strings into out. Bit i % 8 of valid[i / 8] is set
+// if dates[i] has been parsed successfully, otherwise out[i] is set to 0; valid must hold
+// (count + 7) / 8 bytes. Returns the number of successfully parsed strings.
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+parse_iso8601buckets(const std::string_view* dates, std::size_t count,
+                     const iso8601_buckets<Duration>& buckets, long long* out, std::uint8_t* valid,
+                     iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    const detail::bucket_parser<Duration> parser{ buckets };
+    std::size_t                           parsed{ 0 };
+    for (std::size_t i = 0; i < count; i += 8)
+    {
+        const std::size_t n{ count - i < 8 ? count - i : 8 };
+        unsigned int      bits{ 0 };
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            if (parser(dates[i + j], out[i + j], required))
+                out[i + j] = 0;
+            else
+                bits |= 1u << j;
+        }
+        valid[i / 8] = static_cast<std::uint8_t>(bits);
+        for (; bits != 0; bits &= bits - 1)
+            ++parsed;
+    }
+    return parsed;
+}
+
+// Histogram over bucket_count buckets from origin: increments counts[i] for each string falling
+// into bucket i. Returns the number of strings counted; invalid strings and those outside the
+// buckets are skipped.
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+count_iso8601buckets(const std::string_view* dates, std::size_t count,
+                     const iso8601_buckets<Duration>& buckets, std::uint64_t* counts,
+                     std::size_t      bucket_count,
+                     iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    const detail::bucket_parser<Duration> parser{ buckets };
+    std::size_t                           counted{ 0 };
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        long long bucket;
+        // negative indices wrap around to large values
+        if (!parser(dates[i], bucket, required) &&
+            static_cast<unsigned long long>(bucket) < bucket_count)
+        {
+            ++counts[bucket];
+            ++counted;
+        }
+    }
+    return counted;
+}
+
+#if defined(__cpp_lib_span)
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+parse_iso8601buckets(std::span<const std::string_view> dates,
+                     const iso8601_buckets<Duration>& buckets, std::span<long long> out,
+                     std::span<std::uint8_t> valid,
+                     iso8601_required        required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    assert(out.size() >= dates.size());
+    assert(valid.size() >= (dates.size() + 7) / 8);
+    return parse_iso8601buckets(dates.data(), dates.size(), buckets, out.data(), valid.data(),
+                                required);
+}
+
+template <typename Duration = std::chrono::seconds>
+inline std::size_t
+count_iso8601buckets(std::span<const std::string_view> dates,
+                     const iso8601_buckets<Duration>& buckets, std::span<std::uint64_t> counts,
+                     iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    return count_iso8601buckets(dates.data(), dates.size(), buckets, counts.data(), counts.size(),
+                                required);
+}
+#endif
+
+} // namespace core::time
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+namespace core::time {
+
+// Column of strings in Apache Arrow layout: string i is data[offsets[i], offsets[i + 1]), i.e.
+// offsets holds length + 1 entries. Bit i % 8 of validity[i / 8] is cleared for null strings;
+// validity may be nullptr if there are none. For a slice of an array, offset is the index of its
+// first string in both offsets and validity. Offset is std::int32_t for Arrow strings and
+// std::int64_t for large strings.
+template <typename Offset = std::int32_t>
+struct iso8601_string_column
+{
+    static_assert(std::is_integral_v<Offset>, "offsets must be integers");
+
+    const Offset*       offsets;
+    const char*         data;
+    const std::uint8_t* validity;
+    std::size_t         length;
+    std::size_t         offset{ 0 };
+};
+
+namespace detail {
+
+// count bits of validity starting at bit, all set for a column without nulls
+inline unsigned int load_validity(const std::uint8_t* validity, std::size_t bit,
+                                  std::size_t count) noexcept
+{
+    const unsigned int all{ (1u << count) - 1 };
+    if (validity == nullptr)
+        return all;
+    const std::size_t shift{ bit % 8 };
+    unsigned int      bits{ static_cast<unsigned int>(validity[bit / 8]) >> shift };
+    if (shift + count > 8)
+        bits |= static_cast<unsigned int>(validity[bit / 8 + 1]) << (8 - shift);
+    return bits & all;
+}
+
+} // namespace detail
+
+// Parses the strings of column into out, holding ticks of Duration since epoch as an Arrow
+// timestamp array does, without materializing the strings or allocating. Bit i % 8 of
+// valid[i / 8] is set if string i has been parsed successfully; it is cleared and out[i] is 0
+// for null and invalid strings. out must hold column.length values and valid
+// (column.length + 7) / 8 bytes. Returns the number of successfully parsed strings, so that
+// invalid ones can be told apart from nulls by counting the latter.
+template <typename Duration = std::chrono::seconds, typename Offset>
+inline std::size_t
+parse_iso8601column(const iso8601_string_column<Offset>& column, std::int64_t* out,
+                    std::uint8_t*    valid,
+                    iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    using rep = typename Duration::rep;
+    static_assert(std::is_integral_v<rep> && sizeof(rep) <= sizeof(std::int64_t),
+                  "ticks must fit into 64-bit integers");
+
+    const Offset* offsets{ column.offsets + column.offset };
+    auto          string_at = [&column, offsets](std::size_t i) {
+        return std::string_view{ column.data + offsets[i],
+                                 static_cast<std::size_t>(offsets[i + 1] - offsets[i]) };
+    };
+
+    // as in parse_iso8601datetimes, the first pass runs only the canonical fast path; values of
+    // rows it does not parse are zeroed without a branch
+    for (std::size_t i = 0; i < column.length; i += 8)
+    {
+        const std::size_t  n{ std::min<std::size_t>(8, column.length - i) };
+        const unsigned int present{ detail::load_validity(column.validity, column.offset + i, n) };
+        unsigned int       bits{ 0 };
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            time_point<Duration> value;
+            const bool           parsed{ ((present >> j) & 1) &&
+                               detail::parse_iso8601_canonical(string_at(i + j), value) };
+            out[i + j] = parsed ? static_cast<std::int64_t>(value.time_since_epoch().count()) : 0;
+            bits |= static_cast<unsigned int>(parsed) << j;
+        }
+        valid[i / 8] = static_cast<std::uint8_t>(bits);
+    }
+
+    // second pass passes remaining non-null strings to the general parser
+    std::size_t parsed{ 0 };
+    for (std::size_t i = 0; i < column.length; i += 8)
+    {
+        const std::size_t  n{ std::min<std::size_t>(8, column.length - i) };
+        unsigned int       bits{ valid[i / 8] };
+        const unsigned int remaining{
+            detail::load_validity(column.validity, column.offset + i, n) & ~bits
+        };
+        if (remaining != 0)
+        {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                if (!((remaining >> j) & 1))
+                    continue;
+                time_point<Duration> value;
+                if (!detail::parse_iso8601_engine(string_at(i + j), value, required))
+                {
+                    out[i + j] = static_cast<std::int64_t>(value.time_since_epoch().count());
+                    bits |= 1u << j;
+                }
+            }
+            valid[i / 8] = static_cast<std::uint8_t>(bits);
+        }
+        for (; bits != 0; bits &= bits - 1)
+            ++parsed;
+    }
+    return parsed;
+}
+
+} // namespace core::time
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <string_view>
+
+namespace core::time {
+
+// Components of a timestamp as written, without conversion to a time point. Components not
+// present in the string keep their defaults (month and day 1, time 0), so the same layouts are
+// accepted as by try_parse_iso8601datetime. The offset is not applied, hours may be 24 for
+// midnight and seconds 60 for a leap second.
+template <typename Duration = std::chrono::seconds>
+struct iso8601_datetime_fields
+{
+    static_assert(Duration::period::num == 1,
+                  "sub-second part needs a Duration that divides one second");
+
+    int          year{ 0 };
+    unsigned int month{ 1 };
+    unsigned int day{ 1 };
+    unsigned int hours{ 0 };
+    unsigned int minutes{ 0 };
+    unsigned int seconds{ 0 };
+    // fraction of the second, rounded to Duration; fractions of hours or minutes are carried
+    // into minutes and seconds, and a fraction rounded up to a whole unit into the higher
+    // components, up to the date
+    Duration subseconds{ 0 };
+    // east of UTC, 0 for 'Z' and for local time
+    int offset_minutes{ 0 };
+    // number of date and time components present, 1 for 'YYYY' up to 6 with seconds; compared
+    // with iso8601_required in the same way as by try_parse_iso8601datetime
+    int components{ 1 };
+};
+
+namespace detail {
+
+template <typename Duration>
+inline bool parse_iso8601_canonical_fields(std::string_view                   date,
+                                           iso8601_datetime_fields<Duration>& result,
+                                           iso8601_rounding rounding) noexcept
+{
+    canonical_head head;
+    canonical_tail tail;
+    if (!parse_iso8601_canonical_head(date, head) ||
+        !parse_iso8601_canonical_tail<Duration>(date, tail, rounding) ||
+        !is_valid_date(static_cast<int>(head.year), head.month, head.day))
+        return false;
+
+    result = { static_cast<int>(head.year),
+               head.month,
+               head.day,
+               head.hours,
+               tail.minutes,
+               tail.seconds,
+               Duration{ static_cast<typename Duration::rep>(tail.decimals) },
+               0,
+               6 };
+    return true;
+}
+
+// Adds whole seconds carried from a fraction to the time of day, moving to the next day past
+// midnight. Nothing changes without a carry, so hours written as 24 and seconds written as 60 are
+// kept; the latter cannot have a fraction.
+template <typename Duration>
+constexpr void carry_seconds(iso8601_datetime_fields<Duration>& fields,
+                             unsigned int                       carried) noexcept
+{
+    if (carried == 0)
+        return;
+
+    const unsigned int seconds{ fields.seconds + carried };
+    const unsigned int minutes{ fields.minutes + seconds / 60 };
+    fields.seconds = seconds % 60;
+    fields.minutes = minutes % 60;
+    fields.hours += minutes / 60;
+    if (fields.hours < 24)
+        return;
+
+    fields.hours -= 24;
+    if (fields.day < last_day_of_month(fields.year, fields.month))
+        ++fields.day;
+    else if (fields.month < 12)
+    {
+        fields.day = 1;
+        ++fields.month;
+    }
+    else
+    {
+        fields.day   = 1;
+        fields.month = 1;
+        ++fields.year;
+    }
+}
+
+} // namespace detail
+
+// Parses date into its components, applying the same checks and rounding as
+// try_parse_iso8601datetime but skipping the days since epoch calculation. On failure result is
+// left untouched.
+template <typename Duration = std::chrono::seconds>
+inline iso8601_error
+try_parse_iso8601fields(std::string_view date, iso8601_datetime_fields<Duration>& result,
+                        iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                        iso8601_rounding rounding = iso8601_rounding::truncate) noexcept
+{
+    if (detail::parse_iso8601_canonical_fields(date, result, rounding))
+        return {};
+
+    detail::iso8601_fields fields;
+    if (auto error = detail::scan_iso8601_engine<Duration>(date, fields, rounding))
+        return error;
+    if (auto error = detail::check_fields(fields, date.size(), required))
+        return error;
+
+    // decimals are in 1 / den second units, including whole seconds from a fraction of hours or
+    // minutes, in which case the following components are 0; ticks of the time of day are rounded
+    // as a whole, as by convert_fields, so that ties to even depend on the seconds as well
+    constexpr long long den{ Duration::period::den };
+    const long long     whole{ (static_cast<long long>(fields.time_components[0]) * 60 +
+                            fields.time_components[1]) *
+                               60 +
+                           fields.time_components[2] };
+    const long long     ticks{ detail::divide_rounded(
+        whole * den + static_cast<long long>(fields.decimals), fields.residue, 1, rounding) };
+
+    result = { static_cast<int>(fields.date_components[0]),
+               fields.date_components[1],
+               fields.date_components[2],
+               fields.time_components[0],
+               fields.time_components[1],
+               fields.time_components[2],
+               Duration{ static_cast<typename Duration::rep>(ticks % den) },
+               fields.offset.to_minutes(),
+               fields.parsed + 1 };
+    detail::carry_seconds(result, static_cast<unsigned int>(ticks / den - whole));
+    return {};
+}
+
+template <typename Duration = std::chrono::seconds>
+inline iso8601_datetime_fields<Duration>
+parse_iso8601fields(std::string_view date,
+                    iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                    iso8601_rounding rounding = iso8601_rounding::truncate)
+{
+    iso8601_datetime_fields<Duration> result;
+    if (auto error = try_parse_iso8601fields(date, result, required, rounding))
+        throw iso8601_parse_error(error);
+    return result;
+}
+
+} // namespace core::time
@@ -0,0 +1,424 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+#include <utility>
+
+namespace core::time {
+
+// Format tags for parse_iso8601/try_parse_iso8601. A tag is any type with a static pattern
+// member, in which
+//   'YYYY', 'MM', 'DD', 'hh', 'mm', 'ss' stand for digits of respective components,
+//   'f' stands for a fraction digit (up to 9, following 'ss' and a '.' or ',' character),
+//   '+' stands for timezone offset sign ('+' or '-'), 'hh' and 'mm' following it for offset
+//   hours and minutes,
+// and all other characters must match literally.
+namespace iso8601_formats {
+
+struct extended
+{
+    static constexpr char pattern[]{ "YYYY-MM-DDThh:mm:ss" };
+};
+
+struct extended_utc
+{
+    static constexpr char pattern[]{ "YYYY-MM-DDThh:mm:ssZ" };
+};
+
+struct extended_ms_utc
+{
+    static constexpr char pattern[]{ "YYYY-MM-DDThh:mm:ss.fffZ" };
+};
+
+struct extended_offset
+{
+    static constexpr char pattern[]{ "YYYY-MM-DDThh:mm:ss+hh:mm" };
+};
+
+struct basic_utc
+{
+    static constexpr char pattern[]{ "YYYYMMDDThhmmssZ" };
+};
+
+struct extended_date
+{
+    static constexpr char pattern[]{ "YYYY-MM-DD" };
+};
+
+} // namespace iso8601_formats
+
+namespace detail {
+
+enum class format_field
+{
+    literal,
+    year,
+    month,
+    day,
+    hours,
+    minutes,
+    seconds,
+    fraction,
+    sign,
+    offset_hours,
+    offset_minutes,
+};
+
+constexpr std::size_t format_field_count{ 11 };
+
+template <std::size_t Length>
+constexpr std::array<format_field, Length> format_fields(std::string_view pattern) noexcept
+{
+    std::array<format_field, Length> result{};
+    bool                             in_offset{ false };
+    for (std::size_t i = 0; i < Length; ++i)
+    {
+        switch (pattern[i])
+        {
+        case 'Y':
+            result[i] = format_field::year;
+            break;
+        case 'M':
+            result[i] = format_field::month;
+            break;
+        case 'D':
+            result[i] = format_field::day;
+            break;
+        case 'h':
+            result[i] = in_offset ? format_field::offset_hours : format_field::hours;
+            break;
+        case 'm':
+            result[i] = in_offset ? format_field::offset_minutes : format_field::minutes;
+            break;
+        case 's':
+            result[i] = format_field::seconds;
+            break;
+        case 'f':
+            result[i] = format_field::fraction;
+            break;
+        case '+':
+            result[i] = format_field::sign;
+            in_offset = true;
+            break;
+        default:
+            result[i] = format_field::literal;
+            break;
+        }
+    }
+    return result;
+}
+
+// Layout of a format pattern, all members are evaluated at compile time
+template <typename Format>
+struct format_layout
+{
+    static constexpr std::string_view pattern{ Format::pattern };
+    static constexpr std::size_t      length{ pattern.size() };
+
+    static constexpr std::array<format_field, length> fields{ format_fields<length>(pattern) };
+
+    static constexpr std::size_t count(format_field field) noexcept
+    {
+        std::size_t result{ 0 };
+        for (std::size_t i = 0; i < length; ++i)
+            result += fields[i] == field;
+        return result;
+    }
+
+    static constexpr bool has(format_field field) noexcept { return count(field) != 0; }
+
+    static constexpr std::size_t first(format_field field) noexcept
+    {
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (fields[i] == field)
+                return i;
+        }
+        return length;
+    }
+
+    // all characters of the field are adjacent
+    static constexpr bool contiguous(format_field field) noexcept
+    {
+        for (std::size_t i = first(field); i < first(field) + count(field); ++i)
+        {
+            if (fields[i] != field)
+                return false;
+        }
+        return true;
+    }
+
+    static constexpr bool valid() noexcept
+    {
+        for (std::size_t i = 1; i < format_field_count; ++i)
+        {
+            if (!contiguous(static_cast<format_field>(i)))
+                return false;
+        }
+        for (auto field : { format_field::month, format_field::day, format_field::hours,
+                            format_field::minutes, format_field::seconds,
+                            format_field::offset_hours, format_field::offset_minutes })
+        {
+            if (count(field) != 0 && count(field) != 2)
+                return false;
+        }
+        const std::size_t fraction{ first(format_field::fraction) };
+        return count(format_field::year) == 4 &&
+               (!has(format_field::day) || has(format_field::month)) &&
+               (!has(format_field::hours) || has(format_field::day)) &&
+               (!has(format_field::minutes) || has(format_field::hours)) &&
+               (!has(format_field::seconds) || has(format_field::minutes)) &&
+               (!has(format_field::fraction) ||
+                (has(format_field::seconds) && count(format_field::fraction) <= 9 &&
+                 first(format_field::seconds) + 3 == fraction &&
+                 (pattern[fraction - 1] == '.' || pattern[fraction - 1] == ','))) &&
+               count(format_field::sign) <= 1 &&
+               has(format_field::sign) == has(format_field::offset_hours) &&
+               (!has(format_field::sign) ||
+                (has(format_field::hours) &&
+                 first(format_field::sign) + 1 == first(format_field::offset_hours))) &&
+               (!has(format_field::offset_minutes) || has(format_field::offset_hours));
+    }
+
+    // component reported for an error at given position, literals belong to the next field
+    static constexpr iso8601_component component(std::size_t position) noexcept
+    {
+        for (std::size_t i = position; i < length; ++i)
+        {
+            switch (fields[i])
+            {
+            case format_field::literal:
+                continue;
+            case format_field::year:
+                return iso8601_component::year;
+            case format_field::month:
+                return iso8601_component::month;
+            case format_field::day:
+                return iso8601_component::day;
+            case format_field::hours:
+                return iso8601_component::hours;
+            case format_field::minutes:
+                return iso8601_component::minutes;
+            case format_field::seconds:
+            case format_field::fraction:
+                return iso8601_component::seconds;
+            default:
+                return iso8601_component::timezone_offset;
+            }
+        }
+        return iso8601_component::timezone_offset;
+    }
+
+    static constexpr iso8601_errc literal_error(std::size_t position) noexcept
+    {
+        if (pattern[position] == 'T')
+            return iso8601_errc::missing_date_time_delimiter;
+        if (pattern[position] == 'Z')
+            return iso8601_errc::invalid_termination;
+        if (has(format_field::sign) && position > first(format_field::sign))
+            return iso8601_errc::missing_offset_separator;
+        return iso8601_errc::separator_missing;
+    }
+};
+
+// numbers accumulated for each field
+using format_numbers = std::array<unsigned long long, format_field_count>;
+
+// Validates and accumulates a single character at compile-time known position. Returns false
+// instead of branching so that the whole layout is checked by straight-line code.
+template <typename Layout, std::size_t Position>
+inline bool parse_format_character(char ch, format_numbers& numbers, bool& negative) noexcept
+{
+    constexpr format_field field{ Layout::fields[Position] };
+    if constexpr (field == format_field::literal)
+        return ch == Layout::pattern[Position];
+    else if constexpr (field == format_field::sign)
+    {
+        negative = ch == '-';
+        return ch == '+' || ch == '-';
+    }
+    else
+    {
+        const unsigned int digit{ static_cast<unsigned int>(static_cast<unsigned char>(ch)) - '0' };
+        auto&              number{ numbers[static_cast<std::size_t>(field)] };
+        number = number * 10 + digit;
+        return digit <= 9;
+    }
+}
+
+template <typename Layout, std::size_t... Positions>
+inline bool parse_format_characters(const char* p, format_numbers& numbers, bool& negative,
+                                    std::index_sequence<Positions...>) noexcept
+{
+    return (parse_format_character<Layout, Positions>(p[Positions], numbers, negative) & ...);
+}
+
+// Locates the first character that does not fit the layout; called only after the straight-line
+// check has failed.
+template <typename Layout>
+inline iso8601_error format_syntax_error(std::string_view date) noexcept
+{
+    for (std::size_t i = 0; i < Layout::length; ++i)
+    {
+        const iso8601_component component{ Layout::component(i) };
+        const bool              missing{ i >= date.size() };
+        switch (Layout::fields[i])
+        {
+        case format_field::literal:
+            if (missing || date[i] != Layout::pattern[i])
+                return { Layout::literal_error(i), component, i };
+            break;
+        case format_field::sign:
+            if (missing || (date[i] != '+' && date[i] != '-'))
+                return { iso8601_errc::invalid_offset_sign, component, i };
+            break;
+        default:
+            if (missing)
+                return { iso8601_errc::missing_digit, component, i };
+            if (date[i] < '0' || date[i] > '9')
+                return { iso8601_errc::not_a_digit, component, i };
+            break;
+        }
+    }
+    return { iso8601_errc::invalid_termination, iso8601_component::timezone_offset,
+             Layout::length };
+}
+
+} // namespace detail
+
+// Parses date and time in the layout given by Format tag (see iso8601_formats). The layout is
+// resolved at compile time, so all characters are checked at fixed offsets by straight-line
+// code, without separator detection or iso8601_required checks. Validation rules and results
+// are the same as for try_parse_iso8601datetime.
+template <typename Format, typename Duration = std::chrono::seconds>
+inline iso8601_error try_parse_iso8601(std::string_view date, time_point<Duration>& result) noexcept
+{
+    using layout = detail::format_layout<Format>;
+    using detail::format_field;
+
+    static_assert(layout::valid(), "invalid iso8601 format pattern");
+
+    detail::format_numbers numbers{};
+    bool                   negative{ false };
+    if (date.size() != layout::length ||
+        !detail::parse_format_characters<layout>(date.data(), numbers, negative,
+                                                 std::make_index_sequence<layout::length>{}))
+        return detail::format_syntax_error<layout>(date);
+
+    auto number = [&numbers](format_field field) {
+        return numbers[static_cast<std::size_t>(field)];
+    };
+    auto fail_at = [](iso8601_errc code, format_field field) {
+        return iso8601_error{ code, layout::component(layout::first(field)),
+                              layout::first(field) };
+    };
+
+    const unsigned int month_number{ layout::has(format_field::month)
+                                         ? static_cast<unsigned int>(number(format_field::month))
+                                         : 1 };
+    const unsigned int day_number{ layout::has(format_field::day)
+                                       ? static_cast<unsigned int>(number(format_field::day))
+                                       : 1 };
+    const unsigned long long hours{ number(format_field::hours) };
+    const unsigned long long minutes{ number(format_field::minutes) };
+    const unsigned long long seconds{ number(format_field::seconds) };
+
+    unsigned long long decimals{ 0 };
+    if constexpr (layout::has(format_field::fraction))
+    {
+        // scaled as in the general parser, so that the product cannot overflow for any den
+        constexpr detail::fraction_scale scale{ detail::make_fraction_scale(
+            Duration::period::den) };
+        constexpr auto digits{ static_cast<int>(layout::count(format_field::fraction)) };
+        unsigned long long value{ number(format_field::fraction) };
+        if constexpr (digits <= scale.digits)
+            value *= detail::powers_of_10[scale.digits - digits];
+        else
+            value /= detail::powers_of_10[digits - scale.digits];
+        decimals = value * scale.numerator / scale.denominator;
+    }
+
+    const int year_number{ static_cast<int>(number(format_field::year)) };
+    if (!detail::is_valid_date(year_number, month_number, day_number))
+        return fail_at(iso8601_errc::invalid_date, detail::is_valid_month(month_number)
+                                                       ? format_field::day
+                                                       : format_field::month);
+
+    // same rules as in the general parser
+    if (minutes > 59)
+        return fail_at(iso8601_errc::invalid_time, format_field::minutes);
+    if (seconds > 60 || (seconds == 60 && decimals != 0))
+        return fail_at(iso8601_errc::invalid_time, format_field::seconds);
+    if (hours > 24 || (hours == 24 && (minutes != 0 || seconds != 0 || decimals != 0)))
+        return fail_at(iso8601_errc::invalid_time, format_field::hours);
+
+    const detail::timezone_offset offset{
+        !negative, static_cast<unsigned int>(number(format_field::offset_hours)),
+        static_cast<unsigned int>(number(format_field::offset_minutes))
+    };
+    if (!offset.ok())
+        return fail_at(iso8601_errc::invalid_timezone_offset, format_field::sign);
+
+    const long long days{ detail::days_from_civil(year_number, month_number, day_number) };
+    const auto      count{ ((((days * 24 + static_cast<long long>(hours)) * 60 +
+                              static_cast<long long>(minutes) - offset.to_minutes()) *
+                                 60 +
+                             static_cast<long long>(seconds)) *
+                                Duration::period::den +
+                            static_cast<long long>(decimals)) /
+                           Duration::period::num };
+    result = time_point<Duration>{ Duration{ count } };
+    return {};
+}
+
+template <typename Format, typename Duration = std::chrono::seconds>
+inline time_point<Duration> parse_iso8601(std::string_view date)
+{
+    time_point<Duration> result;
+    if (auto error = try_parse_iso8601<Format>(date, result))
+        throw iso8601_parse_error(error);
+    return result;
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// pattern string usable as a template argument, e.g. parse_iso8601<"YYYY-MM-DDThh:mm:ssZ">
+template <std::size_t Size>
+struct iso8601_pattern
+{
+    char value[Size];
+
+    constexpr iso8601_pattern(const char (&pattern)[Size]) noexcept
+    {
+        for (std::size_t i = 0; i < Size; ++i)
+            value[i] = pattern[i];
+    }
+};
+
+namespace detail {
+
+template <iso8601_pattern Pattern>
+struct pattern_format
+{
+    static constexpr const char* pattern{ Pattern.value };
+};
+
+} // namespace detail
+
+template <iso8601_pattern Pattern, typename Duration = std::chrono::seconds>
+inline iso8601_error try_parse_iso8601(std::string_view date, time_point<Duration>& result) noexcept
+{
+    return try_parse_iso8601<detail::pattern_format<Pattern>>(date, result);
+}
+
+template <iso8601_pattern Pattern, typename Duration = std::chrono::seconds>
+inline time_point<Duration> parse_iso8601(std::string_view date)
+{
+    return parse_iso8601<detail::pattern_format<Pattern>, Duration>(date);
+}
+#endif
+
+} // namespace core::time
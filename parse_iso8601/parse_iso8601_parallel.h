@@ -0,0 +1,121 @@
+#pragma once
+
+#include "parse_iso8601_batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace core::time {
+
+struct iso8601_parse_failure
+{
+    // index of the failed string in the input
+    std::size_t   index;
+    iso8601_error error;
+};
+
+namespace detail {
+
+// Runs task(i) for i in [0, tasks) on up to threads threads (0 for all hardware threads), the
+// calling one included. Threads take tasks from a shared counter, so faster threads pick up more
+// tasks; the first exception thrown by a task (e.g. allocation failure) is rethrown after all
+// threads have finished.
+template <typename Task>
+inline void run_parallel(std::size_t tasks, unsigned int threads, Task task)
+{
+    if (threads == 0)
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    threads = static_cast<unsigned int>(std::min<std::size_t>(threads, tasks));
+
+    std::atomic<std::size_t> next_task{ 0 };
+    std::exception_ptr       worker_exception;
+    std::mutex               worker_exception_mutex;
+
+    auto worker = [&]() noexcept {
+        for (std::size_t i = next_task++; i < tasks; i = next_task++)
+        {
+            try
+            {
+                task(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{ worker_exception_mutex };
+                if (!worker_exception)
+                    worker_exception = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads > 1 ? threads - 1 : 0);
+    try
+    {
+        for (unsigned int i = 1; i < threads; ++i)
+            pool.emplace_back(worker);
+    }
+    catch (const std::system_error&)
+    {
+        // continue with threads started so far, the calling thread takes part as well
+    }
+    worker();
+    for (auto& thread : pool)
+        thread.join();
+    if (worker_exception)
+        std::rethrow_exception(worker_exception);
+}
+
+} // namespace detail
+
+// Multi-threaded variant of parse_iso8601datetimes: input is split into chunks that worker
+// threads take from a shared counter, so faster threads pick up more chunks. Returns failures
+// of all chunks merged in input order. threads equal to 0 uses all hardware threads.
+template <typename Duration = std::chrono::seconds>
+inline std::vector<iso8601_parse_failure>
+parse_iso8601datetimes_parallel(const std::string_view* dates, std::size_t count,
+                                time_point<Duration>* out, std::uint8_t* valid,
+                                iso8601_required required = iso8601_required::YYYYMMDDhhmmss,
+                                unsigned int     threads  = 0)
+{
+    // multiple of 8 so that no validity byte is shared between chunks
+    constexpr std::size_t chunk_size{ 16 * 1024 };
+
+    const std::size_t chunks{ (count + chunk_size - 1) / chunk_size };
+    std::vector<std::vector<iso8601_parse_failure>> chunk_failures(chunks);
+
+    detail::run_parallel(chunks, threads, [&](std::size_t chunk) {
+        const std::size_t first{ chunk * chunk_size };
+        const std::size_t size{ std::min(chunk_size, count - first) };
+        if (parse_iso8601datetimes(dates + first, size, out + first, valid + first / 8,
+                                   required) == size)
+            return;
+        // failures are expected to be rare, so parse them once more to get error details
+        for (std::size_t i = first; i < first + size; ++i)
+        {
+            if (valid[i / 8] & (1u << (i % 8)))
+                continue;
+            time_point<Duration> ignored;
+            chunk_failures[chunk].push_back(
+                { i, try_parse_iso8601datetime(dates[i], ignored, required) });
+        }
+    });
+
+    std::size_t total{ 0 };
+    for (const auto& failures : chunk_failures)
+        total += failures.size();
+    std::vector<iso8601_parse_failure> result;
+    result.reserve(total);
+    for (const auto& failures : chunk_failures)
+        result.insert(result.end(), failures.begin(), failures.end());
+    return result;
+}
+
+} // namespace core::time
@@ -0,0 +1,289 @@
+#pragma once
+
+#include "parse_iso8601.h"
+
+#include <chrono>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<ranges>)
+#include <ranges>
+#endif
+
+namespace core::time {
+
+// Time point or error of a string parsed as element of a range, in the manner of std::expected.
+template <typename Duration = std::chrono::seconds>
+struct iso8601_result
+{
+    time_point<Duration> value;
+    iso8601_error        error;
+
+    bool has_value() const noexcept { return !error; }
+
+    explicit operator bool() const noexcept { return has_value(); }
+};
+
+// What a range of parsed strings holds for strings that fail to parse
+enum class iso8601_error_policy
+{
+    // elements are iso8601_result, holding the error
+    report,
+    // elements are time points of the strings parsed successfully, others are left out
+    skip
+};
+
+#if defined(__cpp_lib_ranges)
+
+// View of the strings of V parsed into time points with try_parse_iso8601datetime. Strings are
+// parsed only as elements are read: with iso8601_error_policy::report each time an iterator is
+// dereferenced, as by std::views::transform; with iso8601_error_policy::skip as an iterator is
+// advanced to the next string that can be parsed. Nothing is allocated, cached or thrown, so a
+// const view can be iterated whenever const V can.
+template <std::ranges::input_range V, typename Duration, iso8601_error_policy Policy>
+    requires std::ranges::view<V> &&
+             std::convertible_to<std::ranges::range_reference_t<V>, std::string_view>
+class iso8601_timestamps_view
+    : public std::ranges::view_interface<iso8601_timestamps_view<V, Duration, Policy>>
+{
+public:
+    template <bool Const>
+    class iterator
+    {
+        using base_range = std::conditional_t<Const, const V, V>;
+
+    public:
+        using iterator_concept  = std::conditional_t<std::ranges::forward_range<base_range>,
+                                                    std::forward_iterator_tag,
+                                                    std::input_iterator_tag>;
+        // elements are returned by value
+        using iterator_category = std::input_iterator_tag;
+        using value_type        = std::conditional_t<Policy == iso8601_error_policy::report,
+                                                    iso8601_result<Duration>, time_point<Duration>>;
+        using difference_type   = std::ranges::range_difference_t<base_range>;
+
+        iterator()
+            requires std::default_initializable<std::ranges::iterator_t<base_range>>
+        = default;
+
+        iterator(std::ranges::iterator_t<base_range> current,
+                 std::ranges::sentinel_t<base_range> end, iso8601_required required)
+            : current_(std::move(current))
+            , end_(std::move(end))
+            , required_(required)
+        {
+            if constexpr (Policy == iso8601_error_policy::skip)
+                skip_invalid();
+        }
+
+        value_type operator*() const
+        {
+            if constexpr (Policy == iso8601_error_policy::report)
+            {
+                iso8601_result<Duration> result{};
+                result.error = try_parse_iso8601datetime(std::string_view{ *current_ },
+                                                         result.value, required_);
+                return result;
+            }
+            else
+                return value_;
+        }
+
+        iterator& operator++()
+        {
+            ++current_;
+            if constexpr (Policy == iso8601_error_policy::skip)
+                skip_invalid();
+            return *this;
+        }
+
+        void operator++(int)
+            requires(!std::ranges::forward_range<base_range>)
+        {
+            ++*this;
+        }
+
+        iterator operator++(int)
+            requires std::ranges::forward_range<base_range>
+        {
+            iterator result{ *this };
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const iterator& lhs, const iterator& rhs)
+            requires std::equality_comparable<std::ranges::iterator_t<base_range>>
+        {
+            return lhs.current_ == rhs.current_;
+        }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t)
+        {
+            return it.current_ == it.end_;
+        }
+
+    private:
+        // advances to the first string at or after current_ that can be parsed, keeping its value
+        void skip_invalid()
+        {
+            for (; current_ != end_; ++current_)
+            {
+                if (!try_parse_iso8601datetime(std::string_view{ *current_ }, value_, required_))
+                    return;
+            }
+        }
+
+        std::ranges::iterator_t<base_range> current_{};
+        std::ranges::sentinel_t<base_range> end_{};
+        iso8601_required                    required_{ iso8601_required::YYYYMMDDhhmmss };
+        time_point<Duration>                value_{};
+    };
+
+    iso8601_timestamps_view()
+        requires std::default_initializable<V>
+    = default;
+
+    iso8601_timestamps_view(V base, iso8601_required required)
+        : base_(std::move(base))
+        , required_(required)
+    {
+    }
+
+    V base() const&
+        requires std::copy_constructible<V>
+    {
+        return base_;
+    }
+
+    V base() && { return std::move(base_); }
+
+    // with iso8601_error_policy::skip, parses up to the first valid string
+    iterator<false> begin()
+    {
+        return { std::ranges::begin(base_), std::ranges::end(base_), required_ };
+    }
+
+    iterator<true> begin() const
+        requires std::ranges::input_range<const V> &&
+                 std::convertible_to<std::ranges::range_reference_t<const V>, std::string_view>
+    {
+        return { std::ranges::begin(base_), std::ranges::end(base_), required_ };
+    }
+
+    std::default_sentinel_t end() const noexcept { return std::default_sentinel; }
+
+private:
+    V                base_{};
+    iso8601_required required_{ iso8601_required::YYYYMMDDhhmmss };
+};
+
+namespace detail {
+
+struct iso8601_adaptor_closure_tag
+{
+};
+
+template <typename Left, typename Right>
+class iso8601_composed_adaptor;
+
+// Base of range adaptor closures in the manner of C++23 std::ranges::range_adaptor_closure:
+// range | closure applies the closure to the range, and a closure composed with another one,
+// ours or a standard one such as std::views::transform(f), with | is a closure that applies both.
+template <typename Derived>
+struct iso8601_adaptor_closure : iso8601_adaptor_closure_tag
+{
+    template <std::ranges::viewable_range R>
+        requires std::invocable<const Derived&, R>
+    friend constexpr auto operator|(R&& range, const Derived& closure)
+    {
+        return closure(std::forward<R>(range));
+    }
+
+    template <typename Left>
+        requires(!std::ranges::range<Left>)
+    friend constexpr auto operator|(Left left, const Derived& closure)
+    {
+        return iso8601_composed_adaptor<Left, Derived>{ std::move(left), closure };
+    }
+
+    template <typename Right>
+        requires(!std::ranges::range<Right> &&
+                 !std::derived_from<Right, iso8601_adaptor_closure_tag>)
+    friend constexpr auto operator|(const Derived& closure, Right right)
+    {
+        return iso8601_composed_adaptor<Derived, Right>{ closure, std::move(right) };
+    }
+};
+
+// applies Left, then Right
+template <typename Left, typename Right>
+class iso8601_composed_adaptor
+    : public iso8601_adaptor_closure<iso8601_composed_adaptor<Left, Right>>
+{
+public:
+    constexpr iso8601_composed_adaptor(Left left, Right right)
+        : left_(std::move(left))
+        , right_(std::move(right))
+    {
+    }
+
+    template <std::ranges::viewable_range R>
+        requires requires(R&& range, const Left& left, const Right& right) {
+            std::forward<R>(range) | left | right;
+        }
+    constexpr auto operator()(R&& range) const
+    {
+        return std::forward<R>(range) | left_ | right_;
+    }
+
+private:
+    Left  left_;
+    Right right_;
+};
+
+template <typename Duration, iso8601_error_policy Policy>
+class iso8601_timestamps_adaptor
+    : public iso8601_adaptor_closure<iso8601_timestamps_adaptor<Duration, Policy>>
+{
+public:
+    constexpr explicit iso8601_timestamps_adaptor(iso8601_required required) noexcept
+        : required_(required)
+    {
+    }
+
+    template <std::ranges::viewable_range R>
+        requires std::ranges::input_range<std::views::all_t<R>> &&
+                 std::convertible_to<std::ranges::range_reference_t<std::views::all_t<R>>,
+                                     std::string_view>
+    constexpr auto operator()(R&& range) const
+    {
+        return iso8601_timestamps_view<std::views::all_t<R>, Duration, Policy>{
+            std::views::all(std::forward<R>(range)), required_
+        };
+    }
+
+private:
+    iso8601_required required_;
+};
+
+} // namespace detail
+
+namespace views {
+
+// Range adaptor closure parsing strings lazily, e.g.
+// lines | views::iso8601_timestamps<std::chrono::milliseconds>() | std::views::filter(...); it
+// may also be composed with other closures before it is applied to a range.
+template <typename Duration = std::chrono::seconds,
+          iso8601_error_policy Policy = iso8601_error_policy::report>
+constexpr auto
+iso8601_timestamps(iso8601_required required = iso8601_required::YYYYMMDDhhmmss) noexcept
+{
+    return detail::iso8601_timestamps_adaptor<Duration, Policy>{ required };
+}
+
+} // namespace views
+
+#endif
+
+} // namespace core::time
@@ -0,0 +1,118 @@
+#include "find_iso8601.h"
+#include "iso8601_corpus.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+template <typename Duration = std::chrono::seconds>
+std::vector<iso8601_match<Duration>> find_all(std::string_view text, iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+{
+	std::vector<iso8601_match<Duration>> matches;
+	for_each_iso8601datetime<Duration>(
+		text, [&matches](const iso8601_match<Duration>& match) { matches.push_back(match); }, required);
+	return matches;
+}
+
+std::vector<std::string_view> found_strings(std::string_view text, iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+{
+	std::vector<std::string_view> result;
+	for (const auto& match : find_all(text, required))
+		result.push_back(text.substr(match.offset, match.length));
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("find_iso8601datetime finds timestamps embedded in text")
+{
+	const std::string_view line{ "[2020-08-13T23:10:13.123Z] INFO request 42 from 10.0.0.1 took 5 ms, retried at 20200813T231014Z." };
+
+	const auto matches{ find_all<std::chrono::milliseconds>(line) };
+	REQUIRE(matches.size() == 2);
+	CHECK(matches[0].offset == 1);
+	CHECK(matches[0].length == 24);
+	CHECK(matches[0].value == parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123Z"));
+	CHECK(line.substr(matches[1].offset, matches[1].length) == "20200813T231014Z");
+	CHECK(matches[1].value == parse_iso8601datetime<std::chrono::milliseconds>("20200813T231014Z"));
+
+	iso8601_match<> match{};
+	REQUIRE(find_iso8601datetime(line, match, 2));
+	CHECK(line.substr(match.offset, match.length) == "20200813T231014Z");
+	CHECK_FALSE(find_iso8601datetime(line, match, match.offset + 1));
+	CHECK_FALSE(find_iso8601datetime("no timestamps - at all, 2020-08", match));
+	CHECK_FALSE(find_iso8601datetime("", match));
+}
+
+TEST_CASE("find_iso8601datetime takes the longest shape of the grammar")
+{
+	CHECK(found_strings("at 2020-08-13T23:10:13+05:45: done") == std::vector<std::string_view>{ "2020-08-13T23:10:13+05:45" });
+	CHECK(found_strings("at 2020-08-13T23:10:13\xe2\x88\x92"
+						"03:30.")
+		  == std::vector<std::string_view>{ "2020-08-13T23:10:13\xe2\x88\x92"
+											"03:30" });
+	CHECK(found_strings("2020-08-13T23:10:13,5 and 2020-08-13T23:10:13.") == std::vector<std::string_view>{ "2020-08-13T23:10:13,5", "2020-08-13T23:10:13" });
+	CHECK(found_strings("2020-08-13T23:10Z", iso8601_required::YYYYMMDD) == std::vector<std::string_view>{ "2020-08-13T23:10Z" });
+	CHECK(found_strings("on 2020-08-13, 2020-08-14Tx", iso8601_required::YYYYMMDD) == std::vector<std::string_view>{ "2020-08-13", "2020-08-14" });
+	CHECK(found_strings("\"20200813T23\"", iso8601_required::YYYYMMDDhh) == std::vector<std::string_view>{ "20200813T23" });
+}
+
+TEST_CASE("find_iso8601datetime skips candidates that do not parse")
+{
+	// adjacent digits
+	CHECK(found_strings("12020-08-13T23:10:13Z").empty());
+	CHECK(found_strings("2020-08-13T23:10:13+0545").empty());
+	CHECK(found_strings("120200813T231013Z 20200813T2310131").empty());
+	// invalid components
+	CHECK(found_strings("2020-02-30T23:10:13Z 2020-08-13T24:10:13Z 2020-08-13T23:10:13+15:00").empty());
+	// mixed formats
+	CHECK(found_strings("2020-08-13T231013Z 20200813T23:10:13Z").empty());
+	// missing components
+	CHECK(found_strings("2020-08-13T23:10 2020-08-13").empty());
+	// a skipped candidate does not hide the following one
+	CHECK(found_strings("2020-13-13T23:10:13Z2020-08-13T23:10:13Z") == std::vector<std::string_view>{ "2020-08-13T23:10:13Z" });
+}
+
+TEST_CASE("find_iso8601datetime finds corpus strings in random text")
+{
+	std::mt19937 generator{ 8601 };
+	const char	 filler[]{ "abcdefxyzTZ0123456789 -:.,+[]\"" };
+
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+	{
+		for (const auto& date : generate_iso8601_corpus(kind, 300))
+		{
+			// spaces around the timestamp keep the filler from extending it
+			std::string text;
+			for (int i = std::uniform_int_distribution<>{ 0, 40 }(generator); i > 0; --i)
+				text += filler[std::uniform_int_distribution<std::size_t>{ 0, sizeof(filler) - 2 }(generator)];
+			text += ' ';
+			const std::size_t offset{ text.size() };
+			text += date;
+			text += " ";
+			for (int i = std::uniform_int_distribution<>{ 0, 40 }(generator); i > 0; --i)
+				text += filler[std::uniform_int_distribution<std::size_t>{ 0, sizeof(filler) - 2 }(generator)];
+
+			INFO(text);
+			time_point<std::chrono::microseconds> expected;
+			const bool							  valid{ !try_parse_iso8601datetime(date, expected) };
+			iso8601_match<std::chrono::microseconds> match{};
+			const bool								 found{ find_iso8601datetime(text, match, offset) };
+			CHECK(found == valid);
+			if (found && valid)
+			{
+				CHECK(match.offset == offset);
+				CHECK(match.length == date.size());
+				CHECK(match.value == expected);
+			}
+		}
+	}
+}
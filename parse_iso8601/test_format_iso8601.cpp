@@ -0,0 +1,153 @@
+#include "format_iso8601.h"
+
+#include <catch2/catch.hpp>
+#include <date/date.h>
+
+#include <limits>
+#include <random>
+#include <ratio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace core::time;
+
+TEST_CASE("format_iso8601 writes extended and basic form")
+{
+	const auto tp = parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123Z");
+
+	CHECK(format_iso8601(tp) == "2020-08-13T23:10:13Z");
+	CHECK(format_iso8601(tp, { true, 3 }) == "2020-08-13T23:10:13.123Z");
+	CHECK(format_iso8601(tp, { true, 6 }) == "2020-08-13T23:10:13.123000Z");
+	CHECK(format_iso8601(tp, { true, 2 }) == "2020-08-13T23:10:13.12Z");
+	CHECK(format_iso8601(tp, { false, 3 }) == "20200813T231013.123Z");
+	CHECK(format_iso8601(tp, { true, 0, iso8601_zone::none }) == "2020-08-13T23:10:13");
+	CHECK(format_iso8601(tp, { true, 0, iso8601_zone::offset, 330 }) == "2020-08-14T04:40:13+05:30");
+	CHECK(format_iso8601(tp, { false, 0, iso8601_zone::offset, -210 }) == "20200813T194013-03:30");
+	CHECK(format_iso8601(tp, { true, 0, iso8601_zone::offset, 0 }) == "2020-08-13T23:10:13+00:00");
+}
+
+TEST_CASE("format_iso8601 writes only offsets accepted by the parser")
+{
+	const auto tp = parse_iso8601datetime("2020-08-13T23:10:13Z");
+
+	// the extremes and the last one of each kind
+	for (int offset : { 14 * 60, -12 * 60, 12 * 60 + 45, -(9 * 60 + 30), 10 * 60 + 30, 0 })
+	{
+		INFO(offset);
+		const iso8601_format_options options{ true, 0, iso8601_zone::offset, offset };
+		const auto					 text = format_iso8601(tp, options);
+		CHECK(parse_iso8601datetime(text) == tp);
+		CHECK(format_iso8601(tp, { false, 0, iso8601_zone::offset, offset }).size() == text.size() - 4);
+	}
+
+	// beyond the extremes, not a listed half or three-quarter hour, a day or more, or not
+	// representable as 'hh:mm'
+	for (int offset : { 14 * 60 + 1, 15 * 60, -12 * 60 - 1, -13 * 60, 5 * 60 + 15, 12 * 60 + 30, -(5 * 60 + 30), 24 * 60,
+						-24 * 60, 100 * 60, std::numeric_limits<int>::max(), std::numeric_limits<int>::min() })
+	{
+		INFO(offset);
+		const iso8601_format_options options{ true, 0, iso8601_zone::offset, offset };
+		char						 buffer[iso8601_max_length];
+		CHECK(format_iso8601(tp, buffer, options) == 0);
+		CHECK_THROWS_AS(format_iso8601(tp, options), std::out_of_range);
+	}
+
+	// the offset is not checked without iso8601_zone::offset
+	CHECK(format_iso8601(tp, { true, 0, iso8601_zone::utc, 24 * 60 }) == "2020-08-13T23:10:13Z");
+}
+
+TEST_CASE("format_iso8601 writes dates before epoch and at the range limits")
+{
+	CHECK(format_iso8601(parse_iso8601datetime("1969-12-31T23:59:59Z")) == "1969-12-31T23:59:59Z");
+	CHECK(format_iso8601(parse_iso8601datetime<std::chrono::milliseconds>("1900-02-28T00:00:00.001Z"), { true, 3 }) ==
+		  "1900-02-28T00:00:00.001Z");
+	CHECK(format_iso8601(parse_iso8601datetime("0000-01-01T00:00:00Z")) == "0000-01-01T00:00:00Z");
+	CHECK(format_iso8601(parse_iso8601datetime("9999-12-31T23:59:59Z")) == "9999-12-31T23:59:59Z");
+
+	char buffer[iso8601_max_length];
+	CHECK(format_iso8601(parse_iso8601datetime("9999-12-31T23:59:59Z") + std::chrono::seconds{ 1 }, buffer) == 0);
+	CHECK(format_iso8601(parse_iso8601datetime("0000-01-01T00:00:00Z") - std::chrono::seconds{ 1 }, buffer) == 0);
+	CHECK_THROWS_AS(format_iso8601(parse_iso8601datetime("0000-01-01T00:00:00Z") - std::chrono::seconds{ 1 }),
+					std::out_of_range);
+}
+
+TEST_CASE("format_iso8601 writes time points coarser than minutes")
+{
+	const auto tp = parse_iso8601datetime<std::chrono::hours>("2020-08-13T23:10:13Z");
+
+	CHECK(format_iso8601(tp) == "2020-08-13T23:00:00Z");
+	CHECK(format_iso8601(tp, { true, 3, iso8601_zone::offset, 330 }) == "2020-08-14T04:30:00.000+05:30");
+	CHECK(format_iso8601(tp, { false, 0, iso8601_zone::offset, -210 }) == "20200813T193000-03:30");
+	CHECK(parse_iso8601datetime<std::chrono::hours>(format_iso8601(tp, { true, 0, iso8601_zone::offset, -210 })) == tp);
+
+	using days = std::chrono::duration<long long, std::ratio<86400>>;
+	CHECK(format_iso8601(time_point<days>{ days{ -1 } }, { true, 0, iso8601_zone::offset, 60 }) == "1969-12-31T01:00:00+01:00");
+}
+
+TEST_CASE("format_iso8601 rejects time points whose days do not fit in int")
+{
+	char buffer[iso8601_max_length];
+	// days that wrap to 1970-04-10 in 32 bits, on both sides of epoch
+	for (long long day : { (1LL << 32) + 100, -(1LL << 32) + 100, 1LL << 40, -(1LL << 40) })
+	{
+		INFO(day);
+		const time_point<> tp{ std::chrono::seconds{ day * 86400 } };
+		CHECK(format_iso8601(tp, buffer) == 0);
+		CHECK(format_iso8601(tp, buffer, { true, 0, iso8601_zone::offset, 14 * 60 }) == 0);
+		CHECK_THROWS_AS(format_iso8601(tp), std::out_of_range);
+	}
+	CHECK(format_iso8601(time_point<>{ std::chrono::seconds::max() }, buffer) == 0);
+	CHECK(format_iso8601(time_point<>{ std::chrono::seconds::min() }, buffer, { true, 0, iso8601_zone::offset, -12 * 60 }) == 0);
+	CHECK(format_iso8601(time_point<std::chrono::nanoseconds>{ std::chrono::nanoseconds::max() }, { true, 9 }) ==
+		  "2262-04-11T23:47:16.854775807Z");
+
+	// an offset may move the day back into the range
+	const auto max = parse_iso8601datetime("9999-12-31T23:59:59Z");
+	CHECK(format_iso8601(max + std::chrono::hours{ 1 }, { true, 0, iso8601_zone::offset, -120 }) == "9999-12-31T22:59:59-02:00");
+	CHECK(format_iso8601(max, buffer, { true, 0, iso8601_zone::offset, 60 }) == 0);
+}
+
+TEST_CASE("format_iso8601 writes the same text as ostream")
+{
+	std::mt19937_64 generator{ 8601 };
+	// years 0000 to 9999
+	std::uniform_int_distribution<long long> distribution{ -62167219200000000, 253402300799999999 };
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		const time_point<std::chrono::microseconds> tp{ std::chrono::microseconds{ distribution(generator) } };
+
+		std::ostringstream stream;
+		date::operator<<(stream, tp);
+		std::string expected{ stream.str() };
+		expected[10] = 'T';
+		CHECK(format_iso8601(tp, { true, 6, iso8601_zone::none }) == expected);
+	}
+}
+
+TEST_CASE("format_iso8601 output round-trips through parse_iso8601datetime")
+{
+	std::mt19937_64							 generator{ 8601 };
+	std::uniform_int_distribution<long long> distribution{ -62167219200000000, 253402300799999999 };
+	std::uniform_int_distribution<int>		 offsets{ -12 * 60, 14 * 60 };
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		const time_point<std::chrono::microseconds> tp{ std::chrono::microseconds{ distribution(generator) } };
+		const iso8601_format_options				options{ i % 2 == 0, 6, static_cast<iso8601_zone>(1 + i % 2),
+												 offsets(generator) / 15 * 15 };
+
+		char			  buffer[iso8601_max_length];
+		const std::size_t length = format_iso8601(tp, buffer, options);
+		if (length == 0)
+		{
+			// shifted by the offset outside of four digit years, or an offset the parser rejects
+			CHECK(options.zone == iso8601_zone::offset);
+			continue;
+		}
+		time_point<std::chrono::microseconds> parsed;
+		CHECK_FALSE(try_parse_iso8601datetime({ buffer, length }, parsed));
+		CHECK(parsed == tp);
+	}
+}
@@ -0,0 +1,119 @@
+#include "format_iso8601_batch.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+// mostly increasing time points with random steps, so that runs of them share the day
+std::vector<time_point<std::chrono::microseconds>> generate_time_points(std::size_t count)
+{
+	std::mt19937_64							 generator{ 8601 };
+	std::uniform_int_distribution<long long> step{ -1000000, 3600000000 };
+
+	std::vector<time_point<std::chrono::microseconds>> result;
+	time_point<std::chrono::microseconds>			   tp{ parse_iso8601datetime<std::chrono::microseconds>("1969-12-01T00:00:00Z") };
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		tp += std::chrono::microseconds{ step(generator) };
+		result.push_back(tp);
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("format_iso8601datetimes writes the same strings as format_iso8601")
+{
+	const auto tps = generate_time_points(10000);
+
+	for (const iso8601_format_options& options :
+		 { iso8601_format_options{}, iso8601_format_options{ false, 6 }, iso8601_format_options{ true, 3, iso8601_zone::none },
+		   iso8601_format_options{ true, 9, iso8601_zone::offset, -210 }, iso8601_format_options{ false, 0, iso8601_zone::offset, 345 } })
+	{
+		std::vector<char>		 out(tps.size() * iso8601_max_length);
+		std::vector<std::size_t> offsets(tps.size() + 1);
+
+		CHECK(format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), options) == tps.size());
+		CHECK(offsets[0] == 0);
+		for (std::size_t i = 0; i < tps.size(); ++i)
+		{
+			const std::string_view text{ out.data() + offsets[i], offsets[i + 1] - offsets[i] };
+			CHECK(text == format_iso8601(tps[i], options));
+		}
+	}
+}
+
+TEST_CASE("format_iso8601datetimes output round-trips through parse_iso8601datetime")
+{
+	const auto tps = generate_time_points(10000);
+
+	std::vector<char>		 out(tps.size() * iso8601_max_length);
+	std::vector<std::size_t> offsets(tps.size() + 1);
+	format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), { true, 6, iso8601_zone::offset, 330 });
+	for (std::size_t i = 0; i < tps.size(); ++i)
+	{
+		const std::string_view text{ out.data() + offsets[i], offsets[i + 1] - offsets[i] };
+		CHECK(parse_iso8601datetime<std::chrono::microseconds>(text) == tps[i]);
+	}
+}
+
+TEST_CASE("format_iso8601datetimes writes empty strings for years out of range")
+{
+	const auto max = parse_iso8601datetime("9999-12-31T23:59:59Z");
+
+	const std::vector<time_point<>> tps{ max, max + std::chrono::seconds{ 1 }, max, max + std::chrono::hours{ 24 * 400 } };
+	std::vector<char>				out(tps.size() * iso8601_max_length);
+	std::vector<std::size_t>		offsets(tps.size() + 1);
+
+	CHECK(format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data()) == 2);
+	CHECK(offsets == std::vector<std::size_t>{ 0, 20, 20, 40, 40 });
+	CHECK(std::string_view{ out.data(), 40 } == "9999-12-31T23:59:59Z9999-12-31T23:59:59Z");
+}
+
+TEST_CASE("format_iso8601datetimes writes time points coarser than minutes and far from epoch")
+{
+	using hour_point = time_point<std::chrono::hours>;
+	const auto					  tp = parse_iso8601datetime<std::chrono::hours>("2020-08-13T23:10:13Z");
+	// the third one has a day count that wraps to 1970-04-10 in 32 bits
+	const std::vector<hour_point> tps{ tp, tp + std::chrono::hours{ 1 }, hour_point{ std::chrono::hours{ ((1LL << 32) + 100) * 24 } },
+									   tp + std::chrono::hours{ 2 } };
+	std::vector<char>		 out(tps.size() * iso8601_max_length);
+	std::vector<std::size_t> offsets(tps.size() + 1);
+
+	CHECK(format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), { true, 0, iso8601_zone::offset, 330 }) == 3);
+	CHECK(offsets == std::vector<std::size_t>{ 0, 25, 50, 50, 75 });
+	CHECK(std::string_view{ out.data(), 75 } == "2020-08-14T04:30:00+05:302020-08-14T05:30:00+05:302020-08-14T06:30:00+05:30");
+}
+
+TEST_CASE("format_iso8601datetimes writes empty strings for offsets rejected by the parser")
+{
+	const auto						tp = parse_iso8601datetime("2020-08-13T23:10:13Z");
+	const std::vector<time_point<>> tps{ tp, tp };
+	std::vector<char>				out(tps.size() * iso8601_max_length);
+	std::vector<std::size_t>		offsets(tps.size() + 1, 1);
+
+	CHECK(format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), { true, 0, iso8601_zone::offset, 24 * 60 }) == 0);
+	CHECK(offsets == std::vector<std::size_t>{ 0, 0, 0 });
+	CHECK(format_iso8601datetimes(tps.data(), tps.size(), out.data(), offsets.data(), { true, 0, iso8601_zone::offset, 14 * 60 }) == 2);
+	CHECK(std::string_view{ out.data(), offsets[1] } == "2020-08-14T13:10:13+14:00");
+}
+
+#if defined(__cpp_lib_span)
+TEST_CASE("format_iso8601datetimes accepts spans")
+{
+	const std::vector<time_point<>> tps{ parse_iso8601datetime("2020-08-13T23:10:13Z") };
+	std::vector<char>				out(iso8601_max_length);
+	std::vector<std::size_t>		offsets(2);
+
+	CHECK(format_iso8601datetimes(std::span{ std::as_const(tps) }, std::span{ out }, std::span{ offsets }) == 1);
+	CHECK(std::string_view{ out.data(), offsets[1] } == "2020-08-13T23:10:13Z");
+}
+#endif
@@ -0,0 +1,111 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+template <typename Duration>
+void check_same_as_parse(const std::string& date, iso8601_required required)
+{
+	time_point<Duration> result;
+	INFO(date);
+	CHECK(is_valid_iso8601<Duration>(date, required) == !try_parse_iso8601datetime(date, result, required));
+}
+
+void check_same_as_parse(const std::string& date)
+{
+	for (auto required : { iso8601_required::YYYY, iso8601_required::YYYYMMDD, iso8601_required::YYYYMMDDhhmmss })
+	{
+		check_same_as_parse<std::chrono::seconds>(date, required);
+		check_same_as_parse<std::chrono::milliseconds>(date, required);
+		check_same_as_parse<std::chrono::nanoseconds>(date, required);
+	}
+	check_same_as_parse<std::chrono::minutes>(date, iso8601_required::YYYY);
+}
+
+} // namespace
+
+TEST_CASE("is_valid_iso8601 accepts valid timestamps")
+{
+	CHECK(is_valid_iso8601("2020-08-13T23:10:13Z"));
+	CHECK(is_valid_iso8601("2020-08-13T23:10:13.123456Z"));
+	CHECK(is_valid_iso8601("20200813T231013+05:45"));
+	CHECK(is_valid_iso8601("2020-02-29T00:00:00"));
+	CHECK(is_valid_iso8601("2016-12-31T23:59:60Z"));
+	CHECK(is_valid_iso8601("1970-01-01T24:00:00"));
+	CHECK(is_valid_iso8601("2020-08-13", iso8601_required::YYYYMMDD));
+	CHECK(is_valid_iso8601("2020", iso8601_required::YYYY));
+}
+
+TEST_CASE("is_valid_iso8601 rejects invalid timestamps")
+{
+	CHECK_FALSE(is_valid_iso8601(""));
+	CHECK_FALSE(is_valid_iso8601("2020-08-13"));
+	CHECK_FALSE(is_valid_iso8601("2019-02-29T00:00:00"));
+	CHECK_FALSE(is_valid_iso8601("2020-13-01T00:00:00"));
+	CHECK_FALSE(is_valid_iso8601("2020-08-13T23:60:00"));
+	CHECK_FALSE(is_valid_iso8601("2020-08-13T24:00:01"));
+	CHECK_FALSE(is_valid_iso8601("2020-08-13T23:10:13+05:31"));
+	CHECK_FALSE(is_valid_iso8601("2020-08-13T23:10:13Zx"));
+	CHECK_FALSE(is_valid_iso8601(std::string(65, '0'), iso8601_required::YYYY));
+}
+
+TEST_CASE("is_valid_iso8601 takes fractions of leap second and midnight into account")
+{
+	CHECK(is_valid_iso8601<std::chrono::seconds>("2016-12-31T23:59:60.4Z"));
+	CHECK_FALSE(is_valid_iso8601<std::chrono::milliseconds>("2016-12-31T23:59:60.4Z"));
+	CHECK(is_valid_iso8601<std::chrono::milliseconds>("1970-01-01T24:00:00.0004"));
+	CHECK_FALSE(is_valid_iso8601<std::chrono::microseconds>("1970-01-01T24:00:00.0004"));
+}
+
+TEST_CASE("is_valid_iso8601 agrees with try_parse_iso8601datetime on generated corpora")
+{
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+		for (const auto& date : generate_iso8601_corpus(kind, 500))
+			check_same_as_parse(date);
+}
+
+TEST_CASE("is_valid_iso8601 agrees with try_parse_iso8601datetime on mutated timestamps")
+{
+	std::mt19937 generator{ 8601 };
+	auto		 random = [&generator](std::size_t max) { return std::uniform_int_distribution<std::size_t>{ 0, max }(generator); };
+
+	const std::vector<std::string> samples{ "2020-08-13T23:10:13Z",		   "2020-08-13T23:10:13.123456789Z",
+											"20200813T231013-09:30",		   "2016-12-31T23:59:60,5Z",
+											"1970-01-01T24:00:00",		   "2020-02-29T12:00:00+14",
+											"2020-08-13T23:10.25\xe2\x88\x92"
+											"05:45" };
+	const std::string			   alphabet{ "0123456789-:TZ+.,x" };
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::string date{ samples[random(samples.size() - 1)] };
+		for (std::size_t mutations = random(2); mutations > 0; --mutations)
+		{
+			const std::size_t position{ random(date.size() - 1) };
+			switch (random(2))
+			{
+			case 0:
+				date[position] = alphabet[random(alphabet.size() - 1)];
+				break;
+			case 1:
+				date.erase(position, 1);
+				break;
+			case 2:
+				date.resize(position);
+				break;
+			}
+			if (date.empty())
+				break;
+		}
+		check_same_as_parse(date);
+	}
+}
@@ -0,0 +1,83 @@
+#include "iso8601_cache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+TEST_CASE("iso8601_cache returns the same values as parse_iso8601")
+{
+	const std::vector<std::string_view> dates{ "1970-01-01T23:10:13Z",	 "2020-08-13T23:10:13.123Z",
+											   "19700101T231013Z",		 "1970-01-01T22:30:13+04:00",
+											   "2120-05-30T23:10:13",	 "2020-08-13T23:10:13,123456789Z",
+											   "1900-02-28T23:10:13.5+01" };
+
+	iso8601_cache<std::chrono::milliseconds> cache{ 64 };
+	for (int round = 0; round < 3; ++round)
+	{
+		for (const auto date : dates)
+			CHECK(cache.parse(date) == parse_iso8601datetime<std::chrono::milliseconds>(date));
+	}
+	CHECK(cache.misses() == dates.size());
+	CHECK(cache.hits() == 2 * dates.size());
+}
+
+TEST_CASE("iso8601_cache does not cache invalid strings")
+{
+	iso8601_cache<> cache;
+	time_point<>	result;
+
+	for (int round = 0; round < 2; ++round)
+	{
+		const auto error = cache.try_parse("1970-02-29T23:10:13Z", result);
+		CHECK(error.code == iso8601_errc::invalid_date);
+		CHECK(error.offset == 8);
+		CHECK_THROWS_AS(cache.parse("1970-01-01T25:00:00Z"), iso8601_parse_error);
+	}
+	CHECK(cache.hits() == 0);
+	CHECK(cache.misses() == 4);
+}
+
+TEST_CASE("iso8601_cache passes long strings and required components to the parser")
+{
+	iso8601_cache<std::chrono::nanoseconds> cache{ 16, iso8601_required::YYYYMMDD };
+	const std::string						long_date{ "2020-08-13T23:10:13.123456789123456789123456789Z" };
+
+	CHECK(long_date.size() > iso8601_cache<>::max_key_length);
+	CHECK(cache.parse(long_date) == parse_iso8601datetime<std::chrono::nanoseconds>(long_date));
+	CHECK(cache.parse(long_date) == parse_iso8601datetime<std::chrono::nanoseconds>(long_date));
+	CHECK(cache.hits() == 0);
+
+	CHECK(cache.parse("2020-08-13") == parse_iso8601datetime<std::chrono::nanoseconds>("2020-08-13", iso8601_required::YYYYMMDD));
+	CHECK(cache.parse("2020-08-13") == parse_iso8601datetime<std::chrono::nanoseconds>("2020-08-13", iso8601_required::YYYYMMDD));
+	CHECK(cache.hits() == 1);
+	CHECK_THROWS_AS(cache.parse("2020-08"), iso8601_parse_error);
+}
+
+TEST_CASE("iso8601_cache stays bounded and correct when full")
+{
+	iso8601_cache<> cache{ 10 };
+	CHECK(cache.capacity() == 16);
+
+	for (int round = 0; round < 2; ++round)
+	{
+		for (int i = 0; i < 1000; ++i)
+		{
+			char date[32];
+			std::snprintf(date, sizeof(date), "2020-08-13T%02d:%02d:%02dZ", i / 3600, i / 60 % 60, i % 60);
+			CHECK(cache.parse(date) == parse_iso8601datetime(date));
+		}
+	}
+	CHECK(cache.hits() + cache.misses() == 2000);
+	CHECK(cache.hits() <= cache.capacity());
+
+	cache.clear();
+	CHECK(cache.hits() == 0);
+	CHECK(cache.misses() == 0);
+	cache.parse("2020-08-13T00:00:00Z");
+	CHECK(cache.misses() == 1);
+}
@@ -0,0 +1,87 @@
+#include "parse_iso8601.h"
+
+#include <catch2/catch.hpp>
+#include <date/date.h>
+
+using namespace core::time;
+
+TEST_CASE("days_from_civil counts days from 1970-01-01")
+{
+	static_assert(detail::days_from_civil(1970, 1, 1) == 0);
+	static_assert(detail::days_from_civil(1969, 12, 31) == -1);
+	static_assert(detail::days_from_civil(2000, 3, 1) == 11017);
+	static_assert(detail::days_from_civil(0, 1, 1) == -719528);
+	static_assert(detail::days_from_civil(9999, 12, 31) == 2932896);
+	CHECK(detail::days_from_civil(2020, 8, 13) == 18487);
+}
+
+TEST_CASE("days_from_civil and civil_from_days agree with date for years 0 to 9999")
+{
+	const date::sys_days first{ date::year_month_day{ date::year{ 0 }, date::month{ 1 }, date::day{ 1 } } };
+	const date::sys_days last{ date::year_month_day{ date::year{ 9999 }, date::month{ 12 }, date::day{ 31 } } };
+
+	long long mismatches{ 0 };
+	for (auto day = first; day <= last; day += date::days{ 1 })
+	{
+		const date::year_month_day ymd{ day };
+		const int				   year{ static_cast<int>(ymd.year()) };
+		const unsigned int		   month{ static_cast<unsigned int>(ymd.month()) };
+		const unsigned int		   day_number{ static_cast<unsigned int>(ymd.day()) };
+
+		const auto civil{ detail::civil_from_days(day.time_since_epoch().count()) };
+		if (detail::days_from_civil(year, month, day_number) != day.time_since_epoch().count() || civil.year != year ||
+			civil.month != month || civil.day != day_number)
+		{
+			if (mismatches++ == 0)
+				FAIL_CHECK("first mismatch at " << year << '-' << month << '-' << day_number);
+		}
+	}
+	CHECK(mismatches == 0);
+}
+
+TEST_CASE("days_from_civil increases by one from day to day for years 0 to 9999")
+{
+	long long expected{ detail::days_from_civil(0, 1, 1) };
+	long long mismatches{ 0 };
+	for (int year = 0; year <= 9999; ++year)
+	{
+		for (unsigned int month = 1; month <= 12; ++month)
+		{
+			for (unsigned int day = 1; day <= detail::last_day_of_month(year, month); ++day, ++expected)
+			{
+				const auto civil{ detail::civil_from_days(expected) };
+				if (detail::days_from_civil(year, month, day) != expected || civil.year != year || civil.month != month ||
+					civil.day != day)
+				{
+					if (mismatches++ == 0)
+						FAIL_CHECK("first mismatch at " << year << '-' << month << '-' << day);
+				}
+			}
+		}
+	}
+	CHECK(mismatches == 0);
+	// 2425 leap years
+	CHECK(expected - detail::days_from_civil(0, 1, 1) == 10000LL * 365 + 2425);
+}
+
+TEST_CASE("is_valid_date agrees with date::year_month_day::ok for years 0 to 9999")
+{
+	long long mismatches{ 0 };
+	for (int year = 0; year <= 9999; ++year)
+	{
+		for (unsigned int month = 0; month <= 13; ++month)
+		{
+			for (unsigned int day = 0; day <= 32; ++day)
+			{
+				const date::year_month_day ymd{ date::year{ year }, date::month{ month }, date::day{ day } };
+				if (detail::is_valid_date(year, month, day) != ymd.ok() ||
+					detail::is_valid_month(month) != ymd.month().ok())
+				{
+					if (mismatches++ == 0)
+						FAIL_CHECK("first mismatch at " << year << '-' << month << '-' << day);
+				}
+			}
+		}
+	}
+	CHECK(mismatches == 0);
+}
@@ -0,0 +1,48 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601.h"
+
+#include <catch2/catch.hpp>
+
+using namespace core::time;
+
+TEST_CASE("generate_iso8601_corpus is reproducible for a seed")
+{
+	CHECK(generate_iso8601_corpus(iso8601_corpus_kind::fractional, 100) ==
+		  generate_iso8601_corpus(iso8601_corpus_kind::fractional, 100));
+	CHECK(generate_iso8601_corpus(iso8601_corpus_kind::fractional, 100, 1) !=
+		  generate_iso8601_corpus(iso8601_corpus_kind::fractional, 100, 2));
+}
+
+TEST_CASE("generate_iso8601_corpus yields valid strings of given layout")
+{
+	struct
+	{
+		iso8601_corpus_kind kind;
+		std::size_t			length;
+	} const cases[]{
+		{ iso8601_corpus_kind::canonical, 20 },
+		{ iso8601_corpus_kind::basic, 16 },
+		{ iso8601_corpus_kind::fractional, 27 },
+		{ iso8601_corpus_kind::offset, 25 },
+	};
+	for (const auto& c : cases)
+	{
+		const auto corpus = generate_iso8601_corpus(c.kind, 1000);
+		CHECK(corpus.size() == 1000);
+		for (const auto& date : corpus)
+		{
+			time_point<std::chrono::microseconds> result;
+			CHECK(date.size() == c.length);
+			CHECK_FALSE(try_parse_iso8601datetime(date, result));
+		}
+	}
+}
+
+TEST_CASE("generate_iso8601_corpus yields invalid strings")
+{
+	for (const auto& date : generate_iso8601_corpus(iso8601_corpus_kind::invalid, 1000))
+	{
+		time_point<> result;
+		CHECK(try_parse_iso8601datetime(date, result));
+	}
+}
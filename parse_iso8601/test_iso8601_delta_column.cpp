@@ -0,0 +1,131 @@
+#include "iso8601_corpus.h"
+#include "iso8601_delta_column.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+using milliseconds_point = time_point<std::chrono::milliseconds>;
+
+template <typename Duration>
+iso8601_delta_column<Duration> encode(const std::vector<time_point<Duration>>& values, std::size_t block_size)
+{
+	iso8601_delta_encoder<Duration> encoder{ iso8601_required::YYYYMMDDhhmmss, block_size };
+	for (const auto& value : values)
+		encoder.append(value);
+	return encoder.finish();
+}
+
+template <typename Duration>
+void check_round_trip(const std::vector<time_point<Duration>>& values, std::size_t block_size)
+{
+	const auto column{ encode(values, block_size) };
+	REQUIRE(column.size() == values.size());
+	CHECK(column.block_count() == (values.size() + block_size - 1) / block_size);
+
+	std::vector<time_point<Duration>> decoded(values.size());
+	column.decode(decoded.data());
+	CHECK(decoded == values);
+
+	std::vector<time_point<Duration>> block(block_size);
+	for (std::size_t i = 0; i < column.block_count(); ++i)
+	{
+		const std::size_t count{ column.decode_block(i, block.data()) };
+		CHECK(count == std::min(block_size, values.size() - i * block_size));
+		CHECK(std::equal(block.begin(), block.begin() + count, values.begin() + i * block_size));
+	}
+	for (std::size_t i = 0; i < values.size(); i += 7)
+		CHECK(column[i] == values[i]);
+}
+
+// one timestamp per second with a jitter of a few milliseconds, as in logs of periodic events
+std::vector<milliseconds_point> periodic(std::size_t count)
+{
+	std::mt19937			   generator{ 8601 };
+	std::vector<milliseconds_point> result;
+	milliseconds_point		   value{ std::chrono::milliseconds{ 1597360213000 } };
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		value += std::chrono::milliseconds{ 1000 + std::uniform_int_distribution<>{ -5, 5 }(generator) };
+		result.push_back(value);
+	}
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("iso8601_delta_column decodes what has been encoded")
+{
+	for (std::size_t block_size : { 1, 2, 5, 64, 1024 })
+	{
+		INFO(block_size);
+		check_round_trip(periodic(3000), block_size);
+		check_round_trip(periodic(1), block_size);
+		check_round_trip(std::vector<milliseconds_point>{}, block_size);
+	}
+}
+
+TEST_CASE("iso8601_delta_column encodes any sequence")
+{
+	std::mt19937			   generator{ 8601 };
+	std::vector<milliseconds_point> values;
+	for (int i = 0; i < 2000; ++i)
+	{
+		// each class of delta-of-delta values, unsorted values and extremes
+		const long long magnitudes[]{ 0, 60, 250, 2000, 2000000000LL, std::numeric_limits<long long>::max() };
+		const long long magnitude{ magnitudes[std::uniform_int_distribution<>{ 0, 5 }(generator)] };
+		values.emplace_back(std::chrono::milliseconds{ std::uniform_int_distribution<long long>{ -magnitude, magnitude }(generator) });
+	}
+	values.emplace_back(std::chrono::milliseconds{ std::numeric_limits<long long>::min() });
+	values.emplace_back(std::chrono::milliseconds{ std::numeric_limits<long long>::max() });
+	values.emplace_back(std::chrono::milliseconds{ std::numeric_limits<long long>::min() });
+
+	check_round_trip(values, 100);
+	check_round_trip(values, iso8601_delta_block_size);
+}
+
+TEST_CASE("iso8601_delta_encoder parses strings into the column")
+{
+	const auto corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 500) };
+	std::vector<std::string> dates(corpus.begin(), corpus.end());
+	std::sort(dates.begin(), dates.end());
+
+	iso8601_delta_encoder<std::chrono::microseconds> encoder{ iso8601_required::YYYYMMDDhhmmss, 128 };
+	std::vector<time_point<std::chrono::microseconds>> expected;
+	for (const auto& date : dates)
+	{
+		encoder.append(date);
+		expected.push_back(parse_iso8601datetime<std::chrono::microseconds>(date));
+	}
+	CHECK(encoder.try_append("2020-08-13T24:10:13Z"));
+	CHECK_THROWS_AS(encoder.append("2020-13-13T23:10:13Z"), iso8601_parse_error);
+	CHECK(encoder.size() == dates.size());
+
+	const auto column{ encoder.finish() };
+	CHECK(encoder.size() == 0);
+	std::vector<time_point<std::chrono::microseconds>> decoded(column.size());
+	column.decode(decoded.data());
+	CHECK(decoded == expected);
+}
+
+TEST_CASE("iso8601_delta_column takes a few bits per timestamp of a regular series")
+{
+	const auto values{ periodic(100000) };
+	const auto column{ encode(values, iso8601_delta_block_size) };
+	// jitter of +-5 ms gives delta-of-delta values within +-10, i.e. 9 bits
+	CHECK(column.compressed_bytes() * 8 < values.size() * 10);
+
+	std::vector<milliseconds_point> seconds(100000);
+	for (std::size_t i = 0; i < seconds.size(); ++i)
+		seconds[i] = milliseconds_point{ std::chrono::seconds{ 1597360213 + static_cast<long long>(i) } };
+	// constant intervals take one bit
+	CHECK(encode(seconds, iso8601_delta_block_size).compressed_bytes() * 8 < seconds.size() * 2);
+}
@@ -0,0 +1,182 @@
+#include "iso8601_extract.h"
+#include "iso8601_mapped_file.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+// lines with timestamps in column 1 of CSV and in "time" key of NDJSON, every seventh invalid
+std::string generate_lines(bool json, std::size_t count)
+{
+	std::mt19937 generator{ 8601 };
+	std::string	 result;
+	char		 timestamp[32];
+	char		 line[128];
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::snprintf(timestamp, sizeof(timestamp), "2020-%02d-%02dT%02d:%02d:%02d.%03dZ",
+					  std::uniform_int_distribution<>{ 1, 12 }(generator), std::uniform_int_distribution<>{ 1, 28 }(generator),
+					  std::uniform_int_distribution<>{ 0, 23 }(generator), std::uniform_int_distribution<>{ 0, 59 }(generator),
+					  std::uniform_int_distribution<>{ 0, 59 }(generator), std::uniform_int_distribution<>{ 0, 999 }(generator));
+		if (i % 7 == 3)
+			timestamp[5] = 'x';
+		if (json)
+			std::snprintf(line, sizeof(line), "{\"id\":%zu,\"time\": \"%s\",\"msg\":\"a,b\"}\n", i, timestamp);
+		else
+			std::snprintf(line, sizeof(line), "%zu,%s,\"message, with \"\"quotes\"\"\"\r\n", i, timestamp);
+		result += line;
+	}
+	return result;
+}
+
+std::vector<time_point<std::chrono::milliseconds>> concatenate(const std::vector<iso8601_extract_chunk<std::chrono::milliseconds>>& chunks)
+{
+	std::vector<time_point<std::chrono::milliseconds>> result;
+	for (const auto& chunk : chunks)
+		result.insert(result.end(), chunk.values.begin(), chunk.values.end());
+	return result;
+}
+
+} // namespace
+
+TEST_CASE("find_iso8601_field returns delimited columns")
+{
+	const std::string_view line{ "1,\"a, \"\"b\"\"\",2020-08-13T23:10:13Z,,last" };
+	CHECK(find_iso8601_field(line, { 0, ',', {} }) == "1");
+	CHECK(find_iso8601_field(line, { 1, ',', {} }) == "a, \"\"b\"\"");
+	CHECK(find_iso8601_field(line, { 2, ',', {} }) == "2020-08-13T23:10:13Z");
+	CHECK(find_iso8601_field(line, { 3, ',', {} }).empty());
+	CHECK(find_iso8601_field(line, { 4, ',', {} }) == "last");
+	CHECK(find_iso8601_field(line, { 5, ',', {} }).empty());
+	CHECK(find_iso8601_field("\"2020-08-13T23:10:13Z\"", { 0, ',', {} }) == "2020-08-13T23:10:13Z");
+	CHECK(find_iso8601_field("\"unterminated,2020", { 1, ',', {} }).empty());
+
+	CHECK(find_iso8601_field("2020-08-13T23:10:13Z INFO started", { 0, ' ', {} }) == "2020-08-13T23:10:13Z");
+	CHECK(find_iso8601_field("host\t2020-08-13T23:10:13Z\tINFO", { 1, '\t', {} }) == "2020-08-13T23:10:13Z");
+}
+
+TEST_CASE("find_iso8601_field returns string values of JSON keys")
+{
+	iso8601_field_locator locator;
+	locator.json_key = "ts";
+	CHECK(find_iso8601_field("{\"ts\":\"2020-08-13T23:10:13Z\"}", locator) == "2020-08-13T23:10:13Z");
+	CHECK(find_iso8601_field("{\"msg\":\"ts\", \"ts\" : \"2020-08-13\"}", locator) == "2020-08-13");
+	CHECK(find_iso8601_field("{\"a\":{\"ts\":\"2020\"}}", locator) == "2020");
+	CHECK(find_iso8601_field("{\"tsx\":\"2020\",\"xts\":\"2021\"}", locator).empty());
+	CHECK(find_iso8601_field("{\"ts\":1597360213}", locator).empty());
+	CHECK(find_iso8601_field("{\"ts\":\"2020", locator).empty());
+}
+
+TEST_CASE("extract_iso8601field returns one value per line in order for any chunking")
+{
+	const std::string data{ generate_lines(false, 5000) };
+
+	iso8601_field_locator locator;
+	locator.column = 1;
+
+	// reference: sequential parse of each line
+	std::vector<time_point<std::chrono::milliseconds>> expected;
+	std::size_t										   expected_invalid{ 0 };
+	detail::for_each_line(data, [&](std::string_view line) {
+		time_point<std::chrono::milliseconds> value;
+		if (try_parse_iso8601datetime(find_iso8601_field(line, locator), value))
+		{
+			value = time_point<std::chrono::milliseconds>::min();
+			++expected_invalid;
+		}
+		expected.push_back(value);
+	});
+	REQUIRE(expected.size() == 5000);
+	CHECK(expected_invalid == 714);
+
+	for (std::size_t chunk_size : { std::size_t{ 1 }, std::size_t{ 100 }, std::size_t{ 4096 }, iso8601_extract_chunk_size })
+	{
+		for (unsigned int threads : { 1u, 3u })
+		{
+			const auto	chunks{ extract_iso8601field<std::chrono::milliseconds>(data, locator, iso8601_required::YYYYMMDDhhmmss,
+																				threads, chunk_size) };
+			std::size_t invalid{ 0 };
+			for (const auto& chunk : chunks)
+				invalid += chunk.invalid;
+			CHECK(concatenate(chunks) == expected);
+			CHECK(invalid == expected_invalid);
+		}
+	}
+}
+
+TEST_CASE("split_line_chunks ends chunks at line boundaries")
+{
+	const std::string data{ generate_lines(true, 1000) + "last line without line feed" };
+	const auto		  chunks{ detail::split_line_chunks(data, 1000) };
+	std::size_t		  size{ 0 };
+	for (std::size_t i = 0; i < chunks.size(); ++i)
+	{
+		CHECK(chunks[i].data() == data.data() + size);
+		if (i + 1 < chunks.size())
+		{
+			CHECK(chunks[i].size() >= 1000);
+			CHECK(chunks[i].back() == '\n');
+		}
+		size += chunks[i].size();
+	}
+	CHECK(size == data.size());
+	CHECK(detail::split_line_chunks({}, 1000).empty());
+}
+
+TEST_CASE("summarize_iso8601field returns count and range of NDJSON timestamps")
+{
+	const std::string data{ generate_lines(true, 3000) + "\n\n" };
+
+	iso8601_field_locator locator;
+	locator.json_key = "time";
+
+	const auto chunks{ extract_iso8601field<std::chrono::milliseconds>(data, locator) };
+	auto	   values{ concatenate(chunks) };
+	REQUIRE(values.size() == 3000);
+	values.erase(std::remove(values.begin(), values.end(), time_point<std::chrono::milliseconds>::min()), values.end());
+
+	const auto summary{ summarize_iso8601field<std::chrono::milliseconds>(data, locator, iso8601_required::YYYYMMDDhhmmss, 2, 1024) };
+	CHECK(summary.valid == values.size());
+	CHECK(summary.invalid == 3000 - values.size());
+	CHECK(summary.min == *std::min_element(values.begin(), values.end()));
+	CHECK(summary.max == *std::max_element(values.begin(), values.end()));
+
+	const auto empty{ summarize_iso8601field<std::chrono::milliseconds>({}, locator) };
+	CHECK(empty.valid == 0);
+	CHECK(empty.invalid == 0);
+}
+
+TEST_CASE("iso8601_mapped_file maps file content")
+{
+	const auto path{ std::filesystem::temp_directory_path() / "test_iso8601_mapped_file.csv" };
+	const std::string data{ generate_lines(false, 100) };
+	{
+		std::ofstream file{ path, std::ios::binary };
+		file << data;
+	}
+	{
+		const iso8601_mapped_file mapped{ path.string() };
+		CHECK(mapped.content() == data);
+	}
+	{
+		std::ofstream file{ path, std::ios::binary | std::ios::trunc };
+	}
+	{
+		const iso8601_mapped_file mapped{ path.string() };
+		CHECK(mapped.content().empty());
+	}
+	std::filesystem::remove(path);
+
+	CHECK_THROWS_AS(iso8601_mapped_file{ path.string() }, std::system_error);
+}
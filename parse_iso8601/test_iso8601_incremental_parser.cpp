@@ -0,0 +1,156 @@
+#include "iso8601_corpus.h"
+#include "iso8601_incremental_parser.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+template <typename Duration>
+iso8601_error parse_pieces(iso8601_incremental_parser<Duration>& parser, std::string_view date, const std::vector<std::size_t>& splits,
+						   time_point<Duration>& result)
+{
+	std::size_t begin{ 0 };
+	for (std::size_t split : splits)
+	{
+		parser.feed(date.substr(begin, split - begin));
+		begin = split;
+	}
+	parser.feed(date.substr(begin));
+	return parser.try_finish(result);
+}
+
+template <typename Duration>
+void check_same(const std::string& date, iso8601_required required, iso8601_rounding rounding, const std::vector<std::size_t>& splits)
+{
+	time_point<Duration> expected{};
+	time_point<Duration> result{};
+	const auto			 expected_error = try_parse_iso8601datetime(date, expected, required, rounding);
+
+	iso8601_incremental_parser<Duration> parser{ required, rounding };
+	const auto							 error = parse_pieces(parser, date, splits, result);
+
+	INFO(date);
+	CHECK(error.code == expected_error.code);
+	CHECK(error.component == expected_error.component);
+	CHECK(error.offset == expected_error.offset);
+	if (!expected_error)
+		CHECK(result == expected);
+	CHECK(parser.size() == 0);
+}
+
+// checks the whole string, each split into two pieces and single characters
+void check_same(const std::string& date)
+{
+	std::vector<std::vector<std::size_t>> splits{ {} };
+	for (std::size_t i = 0; i <= date.size(); ++i)
+		splits.push_back({ i });
+	std::vector<std::size_t> characters;
+	for (std::size_t i = 1; i < date.size(); ++i)
+		characters.push_back(i);
+	splits.push_back(characters);
+
+	for (const auto& split : splits)
+	{
+		check_same<std::chrono::seconds>(date, iso8601_required::YYYYMMDDhhmmss, iso8601_rounding::truncate, split);
+		check_same<std::chrono::milliseconds>(date, iso8601_required::YYYY, iso8601_rounding::nearest, split);
+	}
+	check_same<std::chrono::nanoseconds>(date, iso8601_required::YYYY, iso8601_rounding::floor, characters);
+	check_same<std::chrono::minutes>(date, iso8601_required::YYYYMMDD, iso8601_rounding::nearest, characters);
+}
+
+const std::vector<std::string> samples{ "",
+										"2020",
+										"2020-08",
+										"202008",
+										"2020-08-13",
+										"20200813",
+										"2020-08-13-",
+										"2020-08-13-T23",
+										"2020-08-13T23",
+										"2020-08-13T23:10",
+										"2020-08-13T23:10:13",
+										"2020-08-13T23:10:13:",
+										"20200813T231013",
+										"2020-08-13T23:10:13Z",
+										"2020-08-13T23:10:13.123456789Z",
+										"2020-08-13T23:10:13,5+01:00",
+										"2020-08-13T23.5Z",
+										"2020-08-13T23:10.25-03:30",
+										"20200813T231013.999999999999999999999-09:30",
+										"2020-08-13T23:10:13\xe2\x88\x92"
+										"05:45",
+										"2020-08-13T23:10:13\xe2\x88"
+										"05:45",
+										"2020-08-13T23:10:13+0545",
+										"1970-01-01T24:00:00",
+										"2016-12-31T23:59:60Z",
+										"2020-02-30T12:00:00Z",
+										"0000-01-01T00:00:00.000001Z" };
+
+} // namespace
+
+TEST_CASE("iso8601_incremental_parser returns the same as try_parse_iso8601datetime for samples split anywhere")
+{
+	for (const auto& date : samples)
+		check_same(date);
+	for (auto kind : { iso8601_corpus_kind::basic, iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+		for (const auto& date : generate_iso8601_corpus(kind, 20))
+			check_same(date);
+}
+
+TEST_CASE("iso8601_incremental_parser returns the same as try_parse_iso8601datetime for mutated samples")
+{
+	std::mt19937 generator{ 8601 };
+	auto		 random = [&generator](std::size_t max) { return std::uniform_int_distribution<std::size_t>{ 0, max }(generator); };
+
+	// characters relevant to the grammar, including parts of utf-8 minus sign
+	const std::string alphabet{ "0123456789-:TZ+.,x \xe2\x88\x92" };
+
+	for (int i = 0; i < 3000; ++i)
+	{
+		std::string date{ samples[random(samples.size() - 1)] };
+		for (std::size_t mutations = random(3) + 1; mutations > 0; --mutations)
+		{
+			const std::size_t position{ random(date.size()) };
+			const char		  ch{ alphabet[random(alphabet.size() - 1)] };
+			if (random(1) == 0)
+				date.insert(position, 1, ch);
+			else if (position < date.size())
+				date[position] = ch;
+		}
+		check_same(date);
+	}
+}
+
+TEST_CASE("iso8601_incremental_parser reports errors as soon as they are fed")
+{
+	iso8601_incremental_parser<> parser;
+	CHECK_FALSE(parser.feed("2020-0"));
+	const auto error{ parser.feed("8x13") };
+	CHECK(error.code == iso8601_errc::separator_missing);
+	CHECK(error.offset == 7);
+	CHECK(parser.feed("T23:10:13Z").offset == 7);
+	CHECK_THROWS_AS(parser.finish(), iso8601_parse_error);
+
+	// the parser is ready for the next timestamp
+	CHECK_FALSE(parser.feed("2020-08-13T23:"));
+	CHECK(parser.size() == 14);
+	CHECK_FALSE(parser.feed(""));
+	CHECK_FALSE(parser.feed("10:13Z"));
+	CHECK(parser.finish() == parse_iso8601datetime("2020-08-13T23:10:13Z"));
+
+	CHECK(parser.feed("2020-08-13T23:10:13." + std::string(iso8601_max_parse_length, '0')).code == iso8601_errc::input_too_long);
+	parser.reset();
+	CHECK(parser.size() == 0);
+
+	iso8601_incremental_parser<> year{ iso8601_required::YYYY };
+	CHECK_FALSE(year.feed("2020"));
+	CHECK(year.finish() == parse_iso8601datetime("2020", iso8601_required::YYYY));
+}
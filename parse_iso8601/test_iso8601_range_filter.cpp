@@ -0,0 +1,107 @@
+#include "iso8601_corpus.h"
+#include "iso8601_range_filter.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+std::vector<std::string> mixed_dates()
+{
+	std::vector<std::string> dates{ "2020-08-13T23:10:13Z",
+									"2020-08-13T23:10:13",
+									"2020-08-13T23:10:13.999999999Z",
+									"2020-08-13T23:10:13.9999999999Z",
+									"2020-08-13T23:10:14,5",
+									"2020-08-13T23:10:12.5Z",
+									"2020-08-13T23:10:13+00:00",
+									"2020-08-13T23:10:13.5-01:00",
+									"2020-08-13T23:10:13+01:00Z",
+									"2020-08-13T22:10:13\xe2\x88\x92"
+									"01:00",
+									"20200813T231013Z",
+									"2020-08-13",
+									"2020-08-13T23:10",
+									"2020-08-13T23:59:60Z",
+									"2020-08-13T24:00:00Z",
+									"2020-08-14T00:00:00Z",
+									"2020-02-30T23:10:13Z",
+									"2020-08-13T23:60:13Z",
+									"2020-08-13T23:10:13Zx",
+									"2020-08-1xT23:10:13Z",
+									"2020-08-13t23:10:13Z",
+									"0000-01-01T00:00:00Z",
+									"9999-12-31T23:59:59.999Z",
+									"1969-12-31T23:59:59.5Z",
+									"" };
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+	{
+		const auto corpus = generate_iso8601_corpus(kind, 200);
+		dates.insert(dates.end(), corpus.begin(), corpus.end());
+	}
+	return dates;
+}
+
+template <typename Duration>
+void check_same(const std::vector<std::string>& dates, time_point<Duration> begin, time_point<Duration> end,
+				iso8601_required required = iso8601_required::YYYYMMDDhhmmss)
+{
+	const iso8601_range_filter<Duration> filter{ begin, end, required };
+	for (const auto& date : dates)
+	{
+		INFO(date);
+		time_point<Duration> result;
+		const bool			 expected{ !try_parse_iso8601datetime(date, result, required) && result >= begin && result < end };
+		CHECK(filter(date) == expected);
+	}
+}
+
+template <typename Duration>
+void check_bounds(const std::vector<std::string>& dates)
+{
+	const std::vector<std::string> bounds{ "1900-01-01T00:00:00Z", "1969-12-31T23:59:59.5Z", "1970-01-01T00:00:00Z",
+										   "2000-02-29T12:30:00Z", "2020-08-13T23:10:13Z",	 "2020-08-13T23:10:13.5Z",
+										   "2020-08-14T00:00:00Z", "2099-12-31T23:59:59Z" };
+	for (const auto& begin : bounds)
+		for (const auto& end : bounds)
+			check_same(dates, parse_iso8601datetime<Duration>(begin), parse_iso8601datetime<Duration>(end));
+}
+
+} // namespace
+
+TEST_CASE("iso8601_range_filter gives the same result as parsing and comparing")
+{
+	const auto dates{ mixed_dates() };
+	check_bounds<std::chrono::seconds>(dates);
+	check_bounds<std::chrono::milliseconds>(dates);
+	check_bounds<std::chrono::nanoseconds>(dates);
+	check_bounds<std::chrono::minutes>(dates);
+	check_same(dates, parse_iso8601datetime("2020-08-13", iso8601_required::YYYYMMDD), parse_iso8601datetime("2020-08-14", iso8601_required::YYYYMMDD),
+			   iso8601_required::YYYYMMDD);
+}
+
+TEST_CASE("iso8601_range_filter handles bounds beyond years written with four digits")
+{
+	const auto	 dates{ mixed_dates() };
+	const auto	 first{ parse_iso8601datetime<std::chrono::milliseconds>("0000-01-01T00:00:00Z") };
+	const auto	 last{ parse_iso8601datetime<std::chrono::milliseconds>("9999-12-31T23:59:59.999Z") };
+	const auto	 day{ std::chrono::hours{ 24 } };
+	const auto	 now{ parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13Z") };
+	const auto	 past{ first - day * 1000 };
+	const auto	 future{ last + day * 1000 };
+	for (auto begin : { past, first, now, last, future })
+		for (auto end : { past, first, now, last, future })
+			check_same(dates, begin, end);
+
+	const iso8601_range_filter<std::chrono::milliseconds> all{ past, future };
+	CHECK(all("0000-01-01T00:00:00Z"));
+	CHECK(all("9999-12-31T23:59:59.999Z"));
+	CHECK_FALSE(all("9999-99-99T99:99:99"));
+	CHECK(all.begin() == past);
+	CHECK(all.end() == future);
+}
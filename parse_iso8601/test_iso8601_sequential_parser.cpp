@@ -0,0 +1,73 @@
+#include "iso8601_sequential_parser.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+TEST_CASE("iso8601_sequential_parser returns the same values as parse_iso8601 for a nearly monotonic stream")
+{
+	std::mt19937 generator{ 8601 };
+	auto random = [&generator](int min, int max) { return std::uniform_int_distribution<>{ min, max }(generator); };
+
+	// includes suffixes that are invalid or not canonical
+	const char* suffixes[]{ "Z", "", ".123Z", ",5", ".123456789Z", "+01:00", ".5-03:30", "ZZ", "Z+", ".1234567891Z" };
+
+	std::vector<std::string> stream;
+	time_point<> tp{ std::chrono::hours{ 24 * 365 * 50 } };
+	for (int i = 0; i < 20000; ++i)
+	{
+		tp += std::chrono::seconds{ random(0, 400) };
+		const auto days = std::chrono::duration_cast<std::chrono::hours>(tp.time_since_epoch()).count() / 24;
+		const auto secs = tp.time_since_epoch().count() % 86400;
+		// days since 2020-01-01 are mapped onto 28-day months to keep the generator simple
+		const auto day_of_year = days % 336;
+		char	   buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d%s", static_cast<int>(1970 + days / 336),
+					  static_cast<int>(day_of_year / 28 + 1), static_cast<int>(day_of_year % 28 + 1),
+					  static_cast<int>(secs / 3600), static_cast<int>(secs / 60 % 60), static_cast<int>(secs % 60),
+					  suffixes[random(0, 20) < 15 ? 0 : random(0, std::size(suffixes) - 1)]);
+		stream.emplace_back(buffer);
+		// invalid minutes or seconds and leap seconds within a cached hour
+		if (random(0, 50) == 0)
+			stream.emplace_back(std::string{ buffer, 14 } + "60:00Z");
+		if (random(0, 50) == 0)
+			stream.emplace_back(std::string{ buffer, 17 } + "60Z");
+		if (random(0, 50) == 0)
+			stream.emplace_back(std::string{ buffer, 17 } + "5AZ");
+		if (random(0, 100) == 0)
+			stream.emplace_back(std::string{ buffer, 13 });
+	}
+
+	iso8601_sequential_parser<std::chrono::milliseconds> parser;
+	for (const auto& date : stream)
+	{
+		time_point<std::chrono::milliseconds> expected{}, result{};
+		const auto expected_error = try_parse_iso8601datetime(date, expected);
+		const auto error		  = parser.try_parse(date, result);
+		CHECK(error.code == expected_error.code);
+		CHECK(result == expected);
+	}
+}
+
+TEST_CASE("iso8601_sequential_parser applies required components")
+{
+	iso8601_sequential_parser<> parser{ iso8601_required::YYYYMMDD };
+	CHECK(parser.parse("1970-01-01T23:10:13Z") == parse_iso8601datetime("1970-01-01T23:10:13Z"));
+	CHECK(parser.parse("1970-01-01T23:10") == parse_iso8601datetime("1970-01-01T23:10", iso8601_required::YYYYMMDD));
+	CHECK(parser.parse("1970-01-01") == parse_iso8601datetime("1970-01-01", iso8601_required::YYYYMMDD));
+	CHECK_THROWS_AS(parser.parse("1970-01"), iso8601_parse_error);
+	CHECK(parser.parse("1970-01-01T23:10:14Z") == parse_iso8601datetime("1970-01-01T23:10:14Z"));
+}
+
+TEST_CASE("iso8601_sequential_parser reset forgets cached prefix")
+{
+	iso8601_sequential_parser<> parser;
+	CHECK(parser.parse("1970-01-01T23:10:13Z") == parse_iso8601datetime("1970-01-01T23:10:13Z"));
+	parser.reset();
+	CHECK(parser.parse("1970-01-01T23:11:13Z") == parse_iso8601datetime("1970-01-01T23:11:13Z"));
+}
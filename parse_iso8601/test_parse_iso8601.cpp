@@ -3,8 +3,13 @@
 #include "parse_iso8601.h"
 
 #include <catch2/catch.hpp>
+#include <date/date.h>
 
+#include <cstdio>
+#include <random>
 #include <sstream>
+#include <string>
+#include <tuple>
 
 using std::ostringstream;
 
@@ -676,3 +681,265 @@ TEST_CASE("parse_iso8601 throws exception for invalid timezone offset")
 	CHECK_THROWS(parse_iso8601datetime("1970-01-01T23:10:13+01:30"));
 	CHECK_THROWS(parse_iso8601datetime("1970-01-01T23:10:13+00:30"));
 }
+
+TEST_CASE("try_parse_iso8601 returns the same value as parse_iso8601 for valid strings")
+{
+	for (const char* str : { "1970-01-01T23:10:13Z", "2120-05-30T23:10:13", "19700101T231013Z", "1970-01-01", "1970-01",
+							 "1989-10-05T23.50Z", "2020-08-13T23:10:13.12345Z", "2020-08-13T23:10:13,12345",
+							 "1970-01-01T22:30:13+04:00", "1970-01-01T22:30:13-04", "1970-01-01T24:00:00" })
+	{
+		time_point<std::chrono::milliseconds> tp;
+		CHECK_FALSE(try_parse_iso8601datetime(str, tp, iso8601_required::YYYYMM));
+		CHECK(tp == parse_iso8601datetime<std::chrono::milliseconds>(str, iso8601_required::YYYYMM));
+	}
+}
+
+TEST_CASE("try_parse_iso8601 leaves result untouched for invalid string")
+{
+	time_point<> tp{ std::chrono::seconds{ 42 } };
+	CHECK(try_parse_iso8601datetime("1970-13-01T23:10:13", tp).code == iso8601_errc::invalid_date);
+	CHECK(tp.time_since_epoch().count() == 42);
+}
+
+TEST_CASE("try_parse_iso8601 returns error code where parse_iso8601 throws exception")
+{
+	const std::pair<const char*, iso8601_errc> cases[]{
+		{ "A", iso8601_errc::not_a_digit },
+		{ "1970-10-2", iso8601_errc::missing_digit },
+		{ "1970-01-01T23:10:13\xe2\x80\x93" "01:00", iso8601_errc::invalid_offset_sign },
+		{ "1970-0101T23:10:13Z", iso8601_errc::separator_missing },
+		{ "1970T23:10:13Z", iso8601_errc::incomplete_date },
+		{ "19700101 231013Z", iso8601_errc::missing_date_time_delimiter },
+		{ "1970-01-01T23:10:13+0130", iso8601_errc::missing_offset_separator },
+		{ "1970-01-01T23:10:13Z0", iso8601_errc::invalid_termination },
+		{ "1970-01-01T22:13", iso8601_errc::incomplete_time },
+		{ "1970-02-29T23:10:13", iso8601_errc::invalid_date },
+		{ "1970-01-01T24:00:13", iso8601_errc::invalid_time },
+		{ "1970-01-01T23:10:13+14:30", iso8601_errc::invalid_timezone_offset },
+	};
+	for (const auto& [str, expected] : cases)
+	{
+		time_point<> tp;
+		CHECK(try_parse_iso8601datetime(str, tp).code == expected);
+		CHECK_THROWS_WITH(parse_iso8601datetime(str), Catch::Matchers::StartsWith(iso8601_error_message(expected)));
+	}
+}
+
+TEST_CASE("try_parse_iso8601 reports failing component and its offset")
+{
+	const std::tuple<const char*, iso8601_errc, iso8601_component, std::size_t> cases[]{
+		{ "197A-01-01T23:10:13Z", iso8601_errc::not_a_digit, iso8601_component::year, 3 },
+		{ "1970-0X-01T23:10:13Z", iso8601_errc::not_a_digit, iso8601_component::month, 6 },
+		{ "1970-0101T23:10:13Z", iso8601_errc::separator_missing, iso8601_component::day, 7 },
+		{ "1970-01-01T23:1", iso8601_errc::missing_digit, iso8601_component::minutes, 15 },
+		{ "1970-01-01T23:10:13+1", iso8601_errc::missing_digit, iso8601_component::timezone_offset, 21 },
+		{ "1970-01-01T23:10:13Z0", iso8601_errc::invalid_termination, iso8601_component::timezone_offset, 20 },
+		{ "1970-01", iso8601_errc::incomplete_date, iso8601_component::day, 7 },
+		{ "1970-01-01T22:13", iso8601_errc::incomplete_time, iso8601_component::seconds, 16 },
+		{ "1970-13-01T23:10:13", iso8601_errc::invalid_date, iso8601_component::month, 5 },
+		{ "1970-02-29T23:10:13", iso8601_errc::invalid_date, iso8601_component::day, 8 },
+		{ "1970-01-01T25:10:13", iso8601_errc::invalid_time, iso8601_component::hours, 11 },
+		{ "1970-01-01T24:00:13", iso8601_errc::invalid_time, iso8601_component::hours, 11 },
+		{ "1970-01-01T22:60:13", iso8601_errc::invalid_time, iso8601_component::minutes, 14 },
+		{ "19700101T223061", iso8601_errc::invalid_time, iso8601_component::seconds, 13 },
+		{ "1970-01-01T23:10:13+14:30", iso8601_errc::invalid_timezone_offset, iso8601_component::timezone_offset, 19 },
+	};
+	for (const auto& [str, code, component, offset] : cases)
+	{
+		time_point<> tp;
+		const auto error = try_parse_iso8601datetime(str, tp);
+		CHECK(error.code == code);
+		CHECK(error.component == component);
+		CHECK(error.offset == offset);
+	}
+}
+
+TEST_CASE("iso8601_error formats message on request")
+{
+	time_point<> tp;
+	const auto error = try_parse_iso8601datetime("1970-02-29T23:10:13", tp);
+	CHECK(error.message() == "Invalid date (day at offset 8)");
+	CHECK(iso8601_error{}.message() == "Success");
+
+	try
+	{
+		parse_iso8601datetime("1970-01-01T22:60:13");
+		FAIL();
+	}
+	catch (const iso8601_parse_error& e)
+	{
+		CHECK(e.error().code == iso8601_errc::invalid_time);
+		CHECK(e.error().component == iso8601_component::minutes);
+		CHECK(std::string{ e.what() } == "Invalid time (minutes at offset 14)");
+	}
+}
+
+TEST_CASE("parse_iso8601 fast path is taken only for canonical layout")
+{
+	time_point<std::chrono::milliseconds> tp;
+	CHECK(detail::parse_iso8601_canonical("1970-01-01T23:10:13Z", tp));
+	CHECK(detail::parse_iso8601_canonical("1970-01-01T23:10:13", tp));
+	CHECK(detail::parse_iso8601_canonical("1970-01-01T23:10:13.123Z", tp));
+	CHECK(detail::parse_iso8601_canonical("1970-01-01T23:10:13,123456789", tp));
+
+	CHECK_FALSE(detail::parse_iso8601_canonical("19700101T231013Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T23:10:13+01:00", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T23:10:13.1234567891Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01 23:10:13Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970/01-01T23:10:13Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T23:10:1AZ", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T23:10:13ZZ", tp));
+	// values that are left to the general parser
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T24:00:00Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-01-01T22:30:60Z", tp));
+	CHECK_FALSE(detail::parse_iso8601_canonical("1970-02-29T22:30:00Z", tp));
+}
+
+TEST_CASE("parse_iso8601 fast path returns the same value as general parser")
+{
+	std::mt19937 generator{ 8601 };
+	auto random = [&generator](int min, int max) { return std::uniform_int_distribution<>{ min, max }(generator); };
+
+	for (int i = 0; i < 10000; ++i)
+	{
+		char canonical[64];
+		std::snprintf(canonical, sizeof(canonical), "%04d-%02d-%02dT%02d:%02d:%02d.%0*d", random(0, 9999), random(1, 12),
+					  random(1, 28), random(0, 23), random(0, 59), random(0, 59), 6, random(0, 999999));
+		canonical[19 + random(0, 7)] = '\0';
+
+		// time offset is not canonical so general parser is used
+		const std::string with_offset{ std::string{ canonical } + "+00:00" };
+		CHECK(parse_iso8601datetime<std::chrono::microseconds>(std::string{ canonical } + "Z") ==
+			  parse_iso8601datetime<std::chrono::microseconds>(with_offset));
+		CHECK(parse_iso8601datetime<std::chrono::milliseconds>(canonical) ==
+			  parse_iso8601datetime<std::chrono::milliseconds>(with_offset));
+		CHECK(parse_iso8601datetime(canonical) == parse_iso8601datetime(with_offset));
+	}
+}
+
+TEST_CASE("parse_iso8601datetime_constexpr is evaluated at compile time")
+{
+	constexpr auto tp = parse_iso8601datetime_constexpr("1970-01-02T01:00:00+01:00");
+	static_assert(tp.time_since_epoch() == std::chrono::hours{ 24 });
+
+	constexpr auto date_only = parse_iso8601datetime_constexpr("2020-08-13", iso8601_required::YYYYMMDD);
+	CHECK(date_only == parse_iso8601datetime("2020-08-13", iso8601_required::YYYYMMDD));
+
+	CHECK(parse_iso8601datetime_constexpr<std::chrono::milliseconds>("2020-08-13T23:10:13.123+05:30") ==
+		  parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123+05:30"));
+	CHECK_THROWS_AS(parse_iso8601datetime_constexpr("1970-02-29T23:10:13Z"), iso8601_parse_error);
+}
+
+TEST_CASE("_iso8601 literal yields time point with microseconds")
+{
+	constexpr auto tp = "1970-01-01T00:00:01.5Z"_iso8601;
+	static_assert(tp.time_since_epoch() == std::chrono::microseconds{ 1500000 });
+
+	CHECK("2020-08-13T23:10:13.123456-03:30"_iso8601 ==
+		  parse_iso8601datetime<std::chrono::microseconds>("2020-08-13T23:10:13.123456-03:30"));
+	CHECK("2020-08"_iso8601 == parse_iso8601datetime<std::chrono::microseconds>("2020-08-01T00:00:00Z"));
+}
+
+TEST_CASE("parse_iso8601 accepts fractions longer than Duration resolution without overflow")
+{
+	CHECK(parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123456789123456789123456789Z") ==
+		  parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123Z"));
+	CHECK(parse_iso8601datetime<std::chrono::nanoseconds>("2020-08-13T23:10:13.999999999999999999999999+00:00") ==
+		  parse_iso8601datetime<std::chrono::nanoseconds>("2020-08-13T23:10:13.999999999Z"));
+	// fractions of hours and minutes
+	CHECK(parse_iso8601datetime("1970-01-01T01.25Z", iso8601_required::YYYYMMDDhh) ==
+		  time_point<>{ std::chrono::seconds{ 4500 } });
+	CHECK(parse_iso8601datetime("1970-01-01T00:00.0166667Z", iso8601_required::YYYYMMDDhhmm) ==
+		  time_point<>{ std::chrono::seconds{ 1 } });
+	CHECK(parse_iso8601datetime<std::chrono::nanoseconds>("1970-01-01T00.000000000000000277777777Z",
+														  iso8601_required::YYYYMMDDhh) ==
+		  time_point<std::chrono::nanoseconds>{});
+	CHECK_THROWS(parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.1234x"));
+}
+
+TEST_CASE("parse_iso8601 rejects input longer than iso8601_max_parse_length")
+{
+	const std::string longest{ "2020-08-13T23:10:13." + std::string(43, '1') + "Z" };
+	CHECK(longest.size() == iso8601_max_parse_length);
+	CHECK(parse_iso8601datetime<std::chrono::milliseconds>(longest) ==
+		  parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.111Z"));
+
+	time_point<> result;
+	const auto	 error = try_parse_iso8601datetime("2020-08-13T23:10:13." + std::string(44, '1') + "Z", result);
+	CHECK(error.code == iso8601_errc::input_too_long);
+	CHECK(error.offset == iso8601_max_parse_length);
+	CHECK(error.message() == "Input too long (timezone offset at offset 64)");
+}
+
+TEST_CASE("parse_iso8601 rounds fractions finer than Duration")
+{
+	using ms = std::chrono::milliseconds;
+
+	auto parse = [](const char* date, iso8601_rounding rounding) {
+		return parse_iso8601datetime<ms>(date, iso8601_required::YYYYMMDDhhmmss, rounding).time_since_epoch().count();
+	};
+	const auto truncate = iso8601_rounding::truncate;
+	const auto floor	= iso8601_rounding::floor;
+	const auto nearest	= iso8601_rounding::nearest;
+
+	CHECK(parse("1970-01-01T00:00:01.1234Z", truncate) == 1123);
+	CHECK(parse("1970-01-01T00:00:01.1234Z", floor) == 1123);
+	CHECK(parse("1970-01-01T00:00:01.1234Z", nearest) == 1123);
+	CHECK(parse("1970-01-01T00:00:01.1236Z", truncate) == 1123);
+	CHECK(parse("1970-01-01T00:00:01.1236Z", nearest) == 1124);
+	// ties to even
+	CHECK(parse("1970-01-01T00:00:01.1235Z", nearest) == 1124);
+	CHECK(parse("1970-01-01T00:00:01.1225Z", nearest) == 1122);
+	CHECK(parse("1970-01-01T00:00:01.12250000000001Z", nearest) == 1123);
+	// canonical layout and offsets are rounded the same way
+	CHECK(parse("1970-01-01T01:00:01.1236+01:00", nearest) == 1124);
+	// before epoch, fraction digits are always added to later time
+	CHECK(parse("1969-12-31T23:59:59.9996Z", truncate) == -1);
+	CHECK(parse("1969-12-31T23:59:59.9996Z", floor) == -1);
+	CHECK(parse("1969-12-31T23:59:59.9996Z", nearest) == 0);
+	// carried to the next day
+	CHECK(parse_iso8601datetime("1970-01-01T23:59:59.9Z", iso8601_required::YYYYMMDDhhmmss, nearest) ==
+		  time_point<>{ std::chrono::hours{ 24 } });
+	// exact values are the same with all modes
+	CHECK(parse("1970-01-01T00:00:01.123Z", nearest) == 1123);
+	CHECK(parse("1970-01-01T00:00:01.123000Z", floor) == 1123);
+}
+
+TEST_CASE("parse_iso8601 rounds to Duration coarser than seconds")
+{
+	auto parse = [](const char* date, iso8601_rounding rounding) {
+		return parse_iso8601datetime<std::chrono::minutes>(date, iso8601_required::YYYYMMDDhhmmss, rounding)
+			.time_since_epoch()
+			.count();
+	};
+
+	CHECK(parse("1970-01-01T00:01:30Z", iso8601_rounding::truncate) == 1);
+	CHECK(parse("1970-01-01T00:01:30Z", iso8601_rounding::floor) == 1);
+	CHECK(parse("1970-01-01T00:01:30Z", iso8601_rounding::nearest) == 2);
+	CHECK(parse("1970-01-01T00:00:30Z", iso8601_rounding::nearest) == 0);
+	CHECK(parse("1970-01-01T00:00:30.001Z", iso8601_rounding::nearest) == 1);
+	CHECK(parse("1970-01-01T00:00:29.999Z", iso8601_rounding::nearest) == 0);
+
+	CHECK(parse("1969-12-31T23:59:30Z", iso8601_rounding::truncate) == 0);
+	CHECK(parse("1969-12-31T23:59:30Z", iso8601_rounding::floor) == -1);
+	CHECK(parse("1969-12-31T23:59:30Z", iso8601_rounding::nearest) == 0);
+	CHECK(parse("1969-12-31T23:59:29.5Z", iso8601_rounding::nearest) == -1);
+	CHECK(parse("1969-12-31T23:59:00Z", iso8601_rounding::floor) == -1);
+
+	// truncation drops digits finer than seconds first, then truncates towards zero
+	CHECK(parse("1969-12-31T23:59:00.5Z", iso8601_rounding::truncate) == -1);
+	CHECK(parse("1970-01-01T00:59:00.5+01:00", iso8601_rounding::truncate) == -1);
+	CHECK(parse("1969-12-31T23:59:30.5Z", iso8601_rounding::truncate) == 0);
+	CHECK(parse("1969-12-31T23:58:59.999Z", iso8601_rounding::truncate) == -1);
+	CHECK(parse("1969-12-31T23:59:00.5Z", iso8601_rounding::floor) == -1);
+	CHECK(parse("1969-12-31T23:58:59.999Z", iso8601_rounding::floor) == -2);
+
+	auto parse_hours = [](const char* date) {
+		return parse_iso8601datetime<std::chrono::hours>(date, iso8601_required::YYYY).time_since_epoch().count();
+	};
+	CHECK(parse_hours("1969-12-31T23:00:00.25Z") == -1);
+	CHECK(parse_hours("1969-12-31T23:30:00.25Z") == 0);
+	CHECK(parse_hours("1969-12-31T22:59:59.75Z") == -1);
+	CHECK(parse_hours("19691231T23.5Z") == 0);
+	CHECK(parse_hours("19691231T22.99Z") == -1);
+}
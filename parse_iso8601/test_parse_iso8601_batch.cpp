@@ -0,0 +1,80 @@
+#include "parse_iso8601_batch.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+bool is_valid(const std::vector<std::uint8_t>& valid, std::size_t i)
+{
+	return (valid[i / 8] >> (i % 8)) & 1;
+}
+
+} // namespace
+
+TEST_CASE("parse_iso8601datetimes returns the same values as parse_iso8601 for each string")
+{
+	const std::vector<std::string_view> dates{ "1970-01-01T23:10:13Z",		"2020-08-13T23:10:13.123Z",
+											   "19700101T231013Z",			"1970-01-01T22:30:13+04:00",
+											   "2120-05-30T23:10:13",		"1970-01-01T24:00:00",
+											   "1970-01-01T22:30:60",		"2020-08-13T23:10:13,123456789Z",
+											   "1900-02-28T23:10:13.5+01", "1989-10-05T23.50Z" };
+
+	std::vector<time_point<std::chrono::milliseconds>> out(dates.size());
+	std::vector<std::uint8_t>						   valid((dates.size() + 7) / 8);
+
+	CHECK(parse_iso8601datetimes(dates.data(), dates.size(), out.data(), valid.data(), iso8601_required::YYYYMMDDhh) ==
+		  dates.size());
+	for (std::size_t i = 0; i < dates.size(); ++i)
+	{
+		CHECK(is_valid(valid, i));
+		CHECK(out[i] == parse_iso8601datetime<std::chrono::milliseconds>(dates[i], iso8601_required::YYYYMMDDhh));
+	}
+}
+
+TEST_CASE("parse_iso8601datetimes flags invalid strings")
+{
+	const std::vector<std::string_view> dates{ "1970-01-01T23:10:13Z", "1970-13-01T23:10:13Z", "",
+											   "1970-01-01T23:10:13Z", "1970-01-01T22:13",	   "1970-01-01",
+											   "19700101T231013Z",	   "1970-01-01T23:10:13Z", "1970-01-01T23:10:13+15",
+											   "1970-02-29T23:10:13Z", "1970-01-01T23:10:13Z" };
+
+	std::vector<time_point<>> out(dates.size(), time_point<>{ std::chrono::seconds{ 42 } });
+	std::vector<std::uint8_t> valid((dates.size() + 7) / 8, 0xff);
+
+	CHECK(parse_iso8601datetimes(dates.data(), dates.size(), out.data(), valid.data()) == 5);
+
+	const bool expected[]{ true, false, false, true, false, false, true, true, false, false, true };
+	for (std::size_t i = 0; i < dates.size(); ++i)
+	{
+		CHECK(is_valid(valid, i) == expected[i]);
+		if (expected[i])
+			CHECK(out[i] == parse_iso8601datetime(dates[i]));
+		else
+			CHECK(out[i] == time_point<>{});
+	}
+	// bits beyond the last string are cleared
+	CHECK((valid[1] >> 3) == 0);
+}
+
+TEST_CASE("parse_iso8601datetimes accepts empty input")
+{
+	CHECK(parse_iso8601datetimes<std::chrono::seconds>(nullptr, 0, nullptr, nullptr) == 0);
+}
+
+#if defined(__cpp_lib_span)
+TEST_CASE("parse_iso8601datetimes accepts spans")
+{
+	const std::vector<std::string_view> dates{ "1970-01-01T23:10:13Z", "1970-13-01T23:10:13Z" };
+	std::vector<time_point<>>			out(dates.size());
+	std::vector<std::uint8_t>			valid(1);
+
+	CHECK(parse_iso8601datetimes(std::span{ dates }, std::span{ out }, std::span{ valid }) == 1);
+	CHECK(valid[0] == 0b01);
+}
+#endif
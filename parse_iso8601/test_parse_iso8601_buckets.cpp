@@ -0,0 +1,133 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601_buckets.h"
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+// reference: full parse followed by floor division
+template <typename Duration>
+bool expected_bucket(std::string_view date, const iso8601_buckets<Duration>& buckets, long long& bucket)
+{
+	time_point<Duration> result;
+	if (try_parse_iso8601datetime(date, result))
+		return false;
+	const auto difference{ (result - buckets.origin).count() };
+	bucket = difference / buckets.width.count() - (difference % buckets.width.count() < 0);
+	return true;
+}
+
+template <typename Duration>
+void check_buckets(const iso8601_buckets<Duration>& buckets, const std::vector<std::string>& dates)
+{
+	for (const auto& date : dates)
+	{
+		INFO(date);
+		long long  bucket{ -12345 };
+		long long  expected{ -12345 };
+		const bool valid{ expected_bucket(date, buckets, expected) };
+		CHECK(!try_parse_iso8601bucket(date, buckets, bucket) == valid);
+		CHECK(bucket == expected);
+	}
+}
+
+std::vector<std::string> mixed_corpus()
+{
+	std::vector<std::string> mixed{ "2016-12-31T23:59:60Z",	   "2016-12-31T23:59:60.5Z",	  "1970-01-01T24:00:00",
+									"1970-01-01T24:00:00.001", "1969-12-31T23:59:59.999Z", "1900-01-01T00:00:00.5Z",
+									"2020-08-13T23.5Z",		   "2020-08-13T23:10,25+01:00" };
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+	{
+		const auto corpus = generate_iso8601_corpus(kind, 200);
+		mixed.insert(mixed.end(), corpus.begin(), corpus.end());
+	}
+	return mixed;
+}
+
+} // namespace
+
+TEST_CASE("parse_iso8601bucket returns index relative to origin")
+{
+	const iso8601_buckets<> hours{ parse_iso8601datetime("2020-08-13T00:00:00Z"), std::chrono::hours{ 1 } };
+	CHECK(parse_iso8601bucket("2020-08-13T00:00:00Z", hours) == 0);
+	CHECK(parse_iso8601bucket("2020-08-13T00:59:59.999Z", hours) == 0);
+	CHECK(parse_iso8601bucket("2020-08-13T23:10:13Z", hours) == 23);
+	CHECK(parse_iso8601bucket("2020-08-14T01:10:13+02:00", hours) == 23);
+	CHECK(parse_iso8601bucket("2020-08-12T23:59:59Z", hours) == -1);
+	CHECK(parse_iso8601bucket("2020-08-12T23:00:00Z", hours) == -1);
+	CHECK(parse_iso8601bucket("2020-08-12T22:59:59Z", hours) == -2);
+	CHECK_THROWS_AS(parse_iso8601bucket("2020-08-13T25:00:00Z", hours), iso8601_parse_error);
+}
+
+TEST_CASE("try_parse_iso8601bucket agrees with parse and floor for whole second buckets")
+{
+	const auto corpus{ mixed_corpus() };
+	check_buckets(iso8601_buckets<std::chrono::milliseconds>{ {}, std::chrono::minutes{ 1 } }, corpus);
+	check_buckets(iso8601_buckets<std::chrono::microseconds>{ parse_iso8601datetime<std::chrono::microseconds>("2000-01-01T00:00:07Z"),
+															  std::chrono::hours{ 24 } },
+				  corpus);
+	check_buckets(iso8601_buckets<std::chrono::nanoseconds>{ {}, std::chrono::seconds{ 1 } }, corpus);
+	check_buckets(iso8601_buckets<std::chrono::seconds>{ {}, std::chrono::seconds{ 90 } }, corpus);
+}
+
+TEST_CASE("try_parse_iso8601bucket agrees with parse and floor for sub-second buckets")
+{
+	const auto corpus{ mixed_corpus() };
+	check_buckets(iso8601_buckets<std::chrono::milliseconds>{ {}, std::chrono::milliseconds{ 250 } }, corpus);
+	check_buckets(iso8601_buckets<std::chrono::microseconds>{ time_point<std::chrono::microseconds>{ std::chrono::microseconds{ 1 } },
+															  std::chrono::seconds{ 10 } },
+				  corpus);
+}
+
+TEST_CASE("try_parse_iso8601bucket rejects fractions of leap second and midnight representable in Duration")
+{
+	const iso8601_buckets<std::chrono::milliseconds> minutes{ {}, std::chrono::minutes{ 1 } };
+	long long										 bucket;
+	CHECK(try_parse_iso8601bucket("2016-12-31T23:59:60.5Z", minutes, bucket).code == iso8601_errc::invalid_time);
+	CHECK(try_parse_iso8601bucket("1970-01-01T24:00:00.001", minutes, bucket).code == iso8601_errc::invalid_time);
+	CHECK(!try_parse_iso8601bucket("1970-01-01T24:00:00.0001", minutes, bucket));
+	CHECK(bucket == 24 * 60);
+}
+
+TEST_CASE("parse_iso8601buckets stores indices and validity bits")
+{
+	const std::vector<std::string> corpus{ mixed_corpus() };
+	std::vector<std::string_view>  dates(corpus.begin(), corpus.end());
+	const iso8601_buckets<std::chrono::milliseconds> days{ {}, std::chrono::hours{ 24 } };
+
+	std::vector<long long>	  out(dates.size(), -1);
+	std::vector<std::uint8_t> valid((dates.size() + 7) / 8);
+	const std::size_t		  parsed{ parse_iso8601buckets(dates.data(), dates.size(), days, out.data(), valid.data()) };
+
+	std::size_t expected_parsed{ 0 };
+	for (std::size_t i = 0; i < dates.size(); ++i)
+	{
+		INFO(dates[i]);
+		long long  expected{ 0 };
+		const bool is_valid{ expected_bucket(dates[i], days, expected) };
+		expected_parsed += is_valid;
+		CHECK(((valid[i / 8] >> (i % 8)) & 1) == is_valid);
+		CHECK(out[i] == expected);
+	}
+	CHECK(parsed == expected_parsed);
+}
+
+TEST_CASE("count_iso8601buckets builds a histogram of buckets in range")
+{
+	const std::vector<std::string_view> dates{ "2020-08-13T00:00:00Z", "2020-08-13T00:30:00.5Z", "2020-08-13T01:00:00Z",
+											   "2020-08-13T02:59:59Z", "2020-08-13T03:00:00Z",	 "2020-08-12T23:59:59Z",
+											   "2020-08-13T01:00:00+01:00", "invalid" };
+	const iso8601_buckets<std::chrono::milliseconds> hours{ parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T00:00:00Z"),
+															std::chrono::hours{ 1 } };
+
+	std::vector<std::uint64_t> counts(3);
+	CHECK(count_iso8601buckets(dates.data(), dates.size(), hours, counts.data(), counts.size()) == 5);
+	CHECK(counts == std::vector<std::uint64_t>{ 3, 1, 1 });
+}
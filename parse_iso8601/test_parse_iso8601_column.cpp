@@ -0,0 +1,124 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601_batch.h"
+#include "parse_iso8601_column.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+bool is_valid(const std::vector<std::uint8_t>& valid, std::size_t i)
+{
+	return (valid[i / 8] >> (i % 8)) & 1;
+}
+
+// strings in Arrow layout; every third string is null and stored empty, as Arrow writers do
+template <typename Offset>
+struct arrow_strings
+{
+	std::vector<Offset>		  offsets{ 0 };
+	std::string				  data;
+	std::vector<std::uint8_t> validity;
+
+	explicit arrow_strings(const std::vector<std::string>& strings)
+		: validity((strings.size() + 7) / 8)
+	{
+		for (std::size_t i = 0; i < strings.size(); ++i)
+		{
+			if (i % 3 != 1)
+			{
+				data += strings[i];
+				validity[i / 8] |= 1u << (i % 8);
+			}
+			offsets.push_back(static_cast<Offset>(data.size()));
+		}
+	}
+
+	bool is_null(std::size_t i) const { return !is_valid(validity, i); }
+};
+
+std::vector<std::string> mixed_corpus()
+{
+	std::vector<std::string> mixed{ "2020-08-13T23:10:13.123Z", "20200813T231013Z", "2020-08-13T23:10:13+01:00", "", "2020-08-13", "1970-01-01T24:00:00" };
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+	{
+		const auto corpus = generate_iso8601_corpus(kind, 100);
+		mixed.insert(mixed.end(), corpus.begin(), corpus.end());
+	}
+	return mixed;
+}
+
+} // namespace
+
+TEST_CASE("parse_iso8601column returns the same values as parse_iso8601datetimes")
+{
+	const auto					  corpus{ mixed_corpus() };
+	const arrow_strings<std::int32_t> strings{ corpus };
+	std::vector<std::string_view> dates;
+	for (std::size_t i = 0; i < corpus.size(); ++i)
+		dates.push_back(strings.is_null(i) ? std::string_view{ "null" } : std::string_view{ corpus[i] });
+
+	std::vector<time_point<std::chrono::microseconds>> expected(dates.size());
+	std::vector<std::uint8_t>						   expected_valid((dates.size() + 7) / 8);
+	parse_iso8601datetimes(dates.data(), dates.size(), expected.data(), expected_valid.data());
+
+	std::vector<std::int64_t> out(corpus.size(), -1);
+	std::vector<std::uint8_t> valid((corpus.size() + 7) / 8, 0xff);
+	const iso8601_string_column<> column{ strings.offsets.data(), strings.data.data(), strings.validity.data(), corpus.size() };
+	std::size_t				  expected_parsed{ 0 };
+	for (std::size_t i = 0; i < corpus.size(); ++i)
+		expected_parsed += is_valid(expected_valid, i);
+	CHECK(parse_iso8601column<std::chrono::microseconds>(column, out.data(), valid.data()) == expected_parsed);
+	for (std::size_t i = 0; i < corpus.size(); ++i)
+	{
+		INFO(corpus[i]);
+		CHECK(is_valid(valid, i) == is_valid(expected_valid, i));
+		CHECK(out[i] == (is_valid(expected_valid, i) ? expected[i].time_since_epoch().count() : 0));
+	}
+}
+
+TEST_CASE("parse_iso8601column handles columns without nulls, slices and large offsets")
+{
+	const auto								corpus{ generate_iso8601_corpus(iso8601_corpus_kind::fractional, 50) };
+	const arrow_strings<std::int64_t>		strings{ corpus };
+	const iso8601_string_column<std::int64_t> all{ strings.offsets.data(), strings.data.data(), nullptr, corpus.size() };
+
+	std::vector<std::int64_t> out(corpus.size());
+	std::vector<std::uint8_t> valid((corpus.size() + 7) / 8);
+	// null strings are empty, so parsing them fails without a validity bitmap
+	CHECK(parse_iso8601column(all, out.data(), valid.data()) == corpus.size() - (corpus.size() + 1) / 3);
+	for (std::size_t i = 0; i < corpus.size(); ++i)
+		CHECK(is_valid(valid, i) == !strings.is_null(i));
+
+	for (std::size_t offset : { 1, 3, 8, 13 })
+	{
+		INFO(offset);
+		const iso8601_string_column<std::int64_t> slice{ strings.offsets.data(), strings.data.data(), strings.validity.data(),
+														 corpus.size() - offset - 2, offset };
+		std::fill(valid.begin(), valid.end(), std::uint8_t{ 0 });
+		const std::size_t parsed{ parse_iso8601column<std::chrono::milliseconds>(slice, out.data(), valid.data()) };
+		std::size_t		  expected_parsed{ 0 };
+		for (std::size_t i = 0; i < slice.length; ++i)
+		{
+			CHECK(is_valid(valid, i) == !strings.is_null(offset + i));
+			if (strings.is_null(offset + i))
+				CHECK(out[i] == 0);
+			else
+			{
+				++expected_parsed;
+				CHECK(out[i] == parse_iso8601datetime<std::chrono::milliseconds>(corpus[offset + i]).time_since_epoch().count());
+			}
+		}
+		CHECK(parsed == expected_parsed);
+	}
+
+	CHECK(parse_iso8601column(iso8601_string_column<>{ nullptr, nullptr, nullptr, 0 }, out.data(), valid.data()) == 0);
+}
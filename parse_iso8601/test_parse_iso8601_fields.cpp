@@ -0,0 +1,240 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601_fields.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+// the fields written back in canonical layout in UTC, with the offset subtracted
+time_point<std::chrono::nanoseconds> to_time_point(const iso8601_datetime_fields<std::chrono::nanoseconds>& fields)
+{
+	char buffer[64];
+	std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT%02u:%02u:%02u.%09lldZ", fields.year, fields.month, fields.day, fields.hours,
+				  fields.minutes, fields.seconds, static_cast<long long>(fields.subseconds.count()));
+	return parse_iso8601datetime<std::chrono::nanoseconds>(buffer) - std::chrono::minutes{ fields.offset_minutes };
+}
+
+} // namespace
+
+TEST_CASE("parse_iso8601fields returns components of canonical timestamps")
+{
+	const auto fields = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T23:10:13.123456Z");
+	CHECK(fields.year == 2020);
+	CHECK(fields.month == 8);
+	CHECK(fields.day == 13);
+	CHECK(fields.hours == 23);
+	CHECK(fields.minutes == 10);
+	CHECK(fields.seconds == 13);
+	CHECK(fields.subseconds == std::chrono::milliseconds{ 123 });
+	CHECK(fields.offset_minutes == 0);
+	CHECK(fields.components == 6);
+}
+
+TEST_CASE("parse_iso8601fields keeps the offset separate")
+{
+	const auto fields = parse_iso8601fields("20200813T231013\xe2\x88\x92"
+											"03:30");
+	CHECK(fields.day == 13);
+	CHECK(fields.hours == 23);
+	CHECK(fields.offset_minutes == -210);
+	CHECK(parse_iso8601fields("2020-08-13T23:10:13+09:30").offset_minutes == 570);
+}
+
+TEST_CASE("parse_iso8601fields reports components present")
+{
+	auto fields = parse_iso8601fields("2020", iso8601_required::YYYY);
+	CHECK(fields.components == 1);
+	CHECK(fields.month == 1);
+	CHECK(fields.day == 1);
+	CHECK(parse_iso8601fields("2020-08", iso8601_required::YYYY).components == 2);
+	CHECK(parse_iso8601fields("2020-08-13", iso8601_required::YYYY).components == 3);
+	CHECK(parse_iso8601fields("2020-08-13T23", iso8601_required::YYYY).components == 4);
+	CHECK(parse_iso8601fields("2020-08-13T23:10", iso8601_required::YYYY).components == 5);
+}
+
+TEST_CASE("parse_iso8601fields carries fractions of hours and minutes")
+{
+	auto fields = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T23.5105Z", iso8601_required::YYYYMMDDhh);
+	CHECK(fields.hours == 23);
+	CHECK(fields.minutes == 30);
+	CHECK(fields.seconds == 37);
+	CHECK(fields.subseconds == std::chrono::milliseconds{ 800 });
+
+	fields = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T23:10,25", iso8601_required::YYYYMMDDhhmm);
+	CHECK(fields.minutes == 10);
+	CHECK(fields.seconds == 15);
+	CHECK(fields.subseconds == std::chrono::milliseconds{ 0 });
+}
+
+TEST_CASE("parse_iso8601fields carries fractions rounded up to a whole unit into higher components")
+{
+	const auto nearest = iso8601_rounding::nearest;
+
+	auto fields = parse_iso8601fields("2020-08-13T10.9999999999Z", iso8601_required::YYYYMMDDhh, nearest);
+	CHECK(fields.day == 13);
+	CHECK(fields.hours == 11);
+	CHECK(fields.minutes == 0);
+	CHECK(fields.seconds == 0);
+	fields = parse_iso8601fields("2020-08-13T10.9999999999Z", iso8601_required::YYYYMMDDhh);
+	CHECK(fields.hours == 10);
+	CHECK(fields.minutes == 59);
+	CHECK(fields.seconds == 59);
+
+	auto millis = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T10:59.9999999Z", iso8601_required::YYYYMMDDhhmm, nearest);
+	CHECK(millis.hours == 11);
+	CHECK(millis.minutes == 0);
+	CHECK(millis.seconds == 0);
+	CHECK(millis.subseconds == std::chrono::milliseconds{ 0 });
+
+	millis = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T10:20:59.9996Z", iso8601_required::YYYYMMDDhhmmss, nearest);
+	CHECK(millis.minutes == 21);
+	CHECK(millis.seconds == 0);
+	CHECK(millis.subseconds == std::chrono::milliseconds{ 0 });
+	millis = parse_iso8601fields<std::chrono::milliseconds>("2020-08-13T10:20:59.9994Z", iso8601_required::YYYYMMDDhhmmss, nearest);
+	CHECK(millis.minutes == 20);
+	CHECK(millis.seconds == 59);
+	CHECK(millis.subseconds == std::chrono::milliseconds{ 999 });
+
+	// past midnight into the next day, month and year
+	struct
+	{
+		const char*	 date;
+		int			 year;
+		unsigned int month;
+		unsigned int day;
+	} const cases[]{
+		{ "2020-08-13T23.9999999999", 2020, 8, 14 },
+		{ "2020-02-28T23:59.9999999999+01:00", 2020, 2, 29 },
+		{ "2019-02-28T23:59:59.9999999999", 2019, 3, 1 },
+		{ "2020-12-31T23:59:59.9999999999Z", 2021, 1, 1 },
+	};
+	for (const auto& c : cases)
+	{
+		INFO(c.date);
+		fields = parse_iso8601fields(c.date, iso8601_required::YYYYMMDDhh, nearest);
+		CHECK(fields.year == c.year);
+		CHECK(fields.month == c.month);
+		CHECK(fields.day == c.day);
+		CHECK(fields.hours == 0);
+		CHECK(fields.minutes == 0);
+		CHECK(fields.seconds == 0);
+
+		char buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT%02u:%02u:%02uZ", fields.year, fields.month, fields.day, fields.hours,
+					  fields.minutes, fields.seconds);
+		CHECK(parse_iso8601datetime(buffer) - std::chrono::minutes{ fields.offset_minutes } ==
+			  parse_iso8601datetime(c.date, iso8601_required::YYYYMMDDhh, nearest));
+	}
+
+	// nothing is carried from midnight written as 24 or from a leap second
+	fields = parse_iso8601fields("2020-08-13T24:00:00", iso8601_required::YYYYMMDDhh, nearest);
+	CHECK(fields.day == 13);
+	CHECK(fields.hours == 24);
+	fields = parse_iso8601fields("2016-12-31T23:59:60Z", iso8601_required::YYYYMMDDhh, nearest);
+	CHECK(fields.seconds == 60);
+}
+
+TEST_CASE("parse_iso8601fields rounds like try_parse_iso8601datetime")
+{
+	// ties at second resolution, where ties to even depend on the whole seconds
+	const char* const dates[]{ "1970-01-01T00:00:13.5Z",	   "1970-01-01T00:00:12.5Z",	  "1969-12-31T23:59:59.5Z",
+							   "1969-12-31T23:59:58.5Z",	   "2020-08-13T23:10:13,5-03:30", "2020-08-13T23:10:12,5+05:45",
+							   "2020-08-13T23:59:59.5Z",	   "2020-12-31T23:59:59.50Z",	  "2020-08-13T23:10:13.4999999999Z",
+							   "2020-08-13T23:10:13.5000000001Z", "2020-08-13T23:10.25Z",	  "2020-08-13T23:10.75Z",
+							   "2020-08-13T23.99986111Z",	   "2020-08-13T10:20:30Z",		  "2020-08-13T24:00:00Z" };
+	for (auto rounding : { iso8601_rounding::truncate, iso8601_rounding::floor, iso8601_rounding::nearest })
+	{
+		for (const char* date : dates)
+		{
+			INFO(date << " rounding " << static_cast<int>(rounding));
+			iso8601_datetime_fields<> fields;
+			time_point<>			  expected;
+			REQUIRE(!try_parse_iso8601fields(date, fields, iso8601_required::YYYYMMDDhh, rounding));
+			REQUIRE(!try_parse_iso8601datetime(date, expected, iso8601_required::YYYYMMDDhh, rounding));
+			CHECK(fields.subseconds == std::chrono::seconds{ 0 });
+
+			char buffer[64];
+			std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT%02u:%02u:%02uZ", fields.year, fields.month, fields.day, fields.hours,
+						  fields.minutes, fields.seconds);
+			CHECK(parse_iso8601datetime(buffer) - std::chrono::minutes{ fields.offset_minutes } == expected);
+		}
+	}
+	CHECK(parse_iso8601fields("1970-01-01T00:00:13.5Z", iso8601_required::YYYYMMDDhhmmss, iso8601_rounding::nearest).seconds == 14);
+	CHECK(parse_iso8601fields("1970-01-01T00:00:12.5Z", iso8601_required::YYYYMMDDhhmmss, iso8601_rounding::nearest).seconds == 12);
+
+	// and at finer resolutions
+	for (const char* date : { "2020-08-13T23:10:13.0005Z", "2020-08-13T23:10:13.0015Z", "2020-08-13T23:10:13,9995-03:30" })
+	{
+		INFO(date);
+		const auto millis = parse_iso8601fields<std::chrono::milliseconds>(date, iso8601_required::YYYYMMDDhh, iso8601_rounding::nearest);
+		char	   buffer[64];
+		std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02uT%02u:%02u:%02u.%03lldZ", millis.year, millis.month, millis.day, millis.hours,
+					  millis.minutes, millis.seconds, static_cast<long long>(millis.subseconds.count()));
+		CHECK(parse_iso8601datetime<std::chrono::milliseconds>(buffer) - std::chrono::minutes{ millis.offset_minutes } ==
+			  parse_iso8601datetime<std::chrono::milliseconds>(date, iso8601_required::YYYYMMDDhh, iso8601_rounding::nearest));
+	}
+}
+
+TEST_CASE("parse_iso8601fields keeps leap second and midnight")
+{
+	auto fields = parse_iso8601fields("2016-12-31T23:59:60Z");
+	CHECK(fields.minutes == 59);
+	CHECK(fields.seconds == 60);
+	fields = parse_iso8601fields("1970-01-01T24:00:00");
+	CHECK(fields.day == 1);
+	CHECK(fields.hours == 24);
+}
+
+TEST_CASE("parse_iso8601fields truncates subseconds to Duration")
+{
+	CHECK(parse_iso8601fields<std::chrono::microseconds>("2020-08-13T23:10:13.1234569Z").subseconds ==
+		  std::chrono::microseconds{ 123456 });
+	CHECK(parse_iso8601fields("2020-08-13T23:10:13.9Z").subseconds == std::chrono::seconds{ 0 });
+}
+
+TEST_CASE("try_parse_iso8601fields reports the same errors as try_parse_iso8601datetime")
+{
+	for (const char* date : { "", "2020-13-01T00:00:00", "2019-02-29T00:00:00Z", "2020-08-13T23:60:00", "2020-08-13T24:00:01",
+							  "2020-08-13T23:10:13+05:31", "2020-08-13T23:10", "2020-08-13T23:10:13Zx" })
+	{
+		INFO(date);
+		iso8601_datetime_fields<> fields;
+		fields.year = -1;
+		time_point<>	 result;
+		const auto error	   = try_parse_iso8601fields(date, fields);
+		const auto parse_error = try_parse_iso8601datetime(date, result);
+		CHECK(error.code == parse_error.code);
+		CHECK(error.component == parse_error.component);
+		CHECK(error.offset == parse_error.offset);
+		CHECK(fields.year == -1);
+	}
+	CHECK_THROWS_AS(parse_iso8601fields("2020-02-30T00:00:00"), iso8601_parse_error);
+}
+
+TEST_CASE("parse_iso8601fields converted back equals parse_iso8601datetime on generated corpora")
+{
+	for (auto kind : { iso8601_corpus_kind::canonical, iso8601_corpus_kind::basic, iso8601_corpus_kind::fractional,
+					   iso8601_corpus_kind::offset })
+	{
+		for (const auto& date : generate_iso8601_corpus(kind, 500))
+		{
+			INFO(date);
+			CHECK(to_time_point(parse_iso8601fields<std::chrono::nanoseconds>(date)) ==
+				  parse_iso8601datetime<std::chrono::nanoseconds>(date));
+		}
+	}
+	for (const char* date : { "2020-08-13T23.5105Z", "2020-08-13T23:10,25+01:00", "2020-08-13T23:10:13.123456789123-03:30",
+							  "2016-12-31T23:59:60Z", "1970-01-01T24:00:00", "0000-01-01T00:00:00.000001Z" })
+	{
+		INFO(date);
+		CHECK(to_time_point(parse_iso8601fields<std::chrono::nanoseconds>(date, iso8601_required::YYYYMMDDhh)) ==
+			  parse_iso8601datetime<std::chrono::nanoseconds>(date, iso8601_required::YYYYMMDDhh));
+	}
+}
@@ -0,0 +1,185 @@
+#include "parse_iso8601_format.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdio>
+#include <ratio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+struct space_delimited
+{
+	static constexpr char pattern[]{ "YYYY-MM-DD hh:mm:ss,ffffff" };
+};
+
+// generates random strings in given printf format, filled with year, month, day, hours, minutes, seconds and
+// milliseconds
+std::vector<std::string> generate(const char* format)
+{
+	std::mt19937 generator{ 8601 };
+	auto random = [&generator](int min, int max) { return std::uniform_int_distribution<>{ min, max }(generator); };
+
+	std::vector<std::string> result;
+	for (int i = 0; i < 1000; ++i)
+	{
+		char buffer[64];
+		std::snprintf(buffer, sizeof(buffer), format, random(1, 9999), random(1, 12), random(1, 28), random(0, 23),
+					  random(0, 59), random(0, 59), random(0, 999));
+		result.emplace_back(buffer);
+	}
+	return result;
+}
+
+struct nanoseconds_utc
+{
+	static constexpr char pattern[]{ "YYYY-MM-DDThh:mm:ss.fffffffffZ" };
+};
+
+} // namespace
+
+TEST_CASE("parse_iso8601 returns the same values as parse_iso8601datetime")
+{
+	for (const auto& date : generate("%04d-%02d-%02dT%02d:%02d:%02d"))
+		CHECK(parse_iso8601<iso8601_formats::extended>(date) == parse_iso8601datetime(date));
+	for (const auto& date : generate("%04d-%02d-%02dT%02d:%02d:%02dZ"))
+		CHECK(parse_iso8601<iso8601_formats::extended_utc>(date) == parse_iso8601datetime(date));
+	for (const auto& date : generate("%04d-%02d-%02dT%02d:%02d:%02d.%.3dZ"))
+	{
+		const auto expected = parse_iso8601datetime<std::chrono::microseconds>(date);
+		CHECK(parse_iso8601<iso8601_formats::extended_ms_utc, std::chrono::microseconds>(date) == expected);
+	}
+	for (const auto& date : generate("%04d%02d%02dT%02d%02d%02dZ"))
+		CHECK(parse_iso8601<iso8601_formats::basic_utc>(date) == parse_iso8601datetime(date));
+	for (const auto& date : generate("%04d-%02d-%02d"))
+	{
+		const auto expected = parse_iso8601datetime(date, iso8601_required::YYYYMMDD);
+		CHECK(parse_iso8601<iso8601_formats::extended_date>(date) == expected);
+	}
+
+	for (const char* offset : { "+00:00", "+05:30", "-03:30", "+14:00", "-12:00", "+08:45" })
+	{
+		for (const auto& date : generate((std::string{ "%04d-%02d-%02dT%02d:%02d:%02d" } + offset).c_str()))
+			CHECK(parse_iso8601<iso8601_formats::extended_offset>(date) == parse_iso8601datetime(date));
+	}
+}
+
+TEST_CASE("parse_iso8601 accepts the same special values as parse_iso8601datetime")
+{
+	using namespace iso8601_formats;
+
+	for (const char* date : { "1970-01-01T24:00:00Z", "2016-12-31T23:59:60Z", "2020-02-29T00:00:00Z" })
+		CHECK(parse_iso8601<extended_utc>(date) == parse_iso8601datetime(date));
+	CHECK(parse_iso8601<extended_offset, std::chrono::minutes>("1970-01-01T00:00:00-09:30") ==
+		  time_point<std::chrono::minutes>{ std::chrono::minutes{ 9 * 60 + 30 } });
+}
+
+TEST_CASE("parse_iso8601 accepts custom format tags")
+{
+	CHECK(parse_iso8601<space_delimited, std::chrono::microseconds>("2020-08-13 23:10:13,123456") ==
+		  parse_iso8601datetime<std::chrono::microseconds>("2020-08-13T23:10:13.123456"));
+	CHECK_THROWS_AS(parse_iso8601<space_delimited>("2020-08-13T23:10:13,123456"), iso8601_parse_error);
+}
+
+TEST_CASE("parse_iso8601 converts fractions to fine Durations without overflow")
+{
+	using picoseconds = std::chrono::duration<long long, std::pico>;
+	// the finest unit the general parser supports, hours must be representable in fraction units
+	using femtoseconds = std::chrono::duration<long long, std::femto>;
+	using attoseconds  = std::chrono::duration<long long, std::atto>;
+
+	for (const char* date : { "1970-01-01T00:00:01.999999999Z", "1970-01-01T00:00:00.000000001Z", "1969-12-31T23:59:59.123456789Z" })
+	{
+		CHECK(parse_iso8601<nanoseconds_utc, picoseconds>(date) == parse_iso8601datetime<picoseconds>(date));
+		CHECK(parse_iso8601<nanoseconds_utc, femtoseconds>(date) == parse_iso8601datetime<femtoseconds>(date));
+	}
+	CHECK(parse_iso8601<nanoseconds_utc, attoseconds>("1970-01-01T00:00:01.999999999Z").time_since_epoch().count() ==
+		  1999999999000000000);
+	// digits finer than Duration are dropped
+	CHECK(parse_iso8601<nanoseconds_utc, std::chrono::microseconds>("1970-01-01T00:00:01.999999999Z").time_since_epoch().count() ==
+		  1999999);
+}
+
+TEST_CASE("try_parse_iso8601 reports error code, component and offset")
+{
+	using namespace iso8601_formats;
+
+	struct
+	{
+		const char*		  date;
+		iso8601_errc	  code;
+		iso8601_component component;
+		std::size_t		  offset;
+	} const cases[]{
+		{ "1970-01-01T23:10:1", iso8601_errc::missing_digit, iso8601_component::seconds, 18 },
+		{ "1970-01-01T23:10:13Z", iso8601_errc::invalid_termination, iso8601_component::timezone_offset, 19 },
+		{ "1970-01-01", iso8601_errc::missing_date_time_delimiter, iso8601_component::hours, 10 },
+		{ "1970-0a-01T23:10:13", iso8601_errc::not_a_digit, iso8601_component::month, 6 },
+		{ "1970-01-01T23-10:13", iso8601_errc::separator_missing, iso8601_component::minutes, 13 },
+		{ "1970-02-29T23:10:13", iso8601_errc::invalid_date, iso8601_component::day, 8 },
+		{ "1970-13-01T23:10:13", iso8601_errc::invalid_date, iso8601_component::month, 5 },
+		{ "1970-01-01T23:60:13", iso8601_errc::invalid_time, iso8601_component::minutes, 14 },
+		{ "1970-01-01T23:10:61", iso8601_errc::invalid_time, iso8601_component::seconds, 17 },
+		{ "1970-01-01T24:00:01", iso8601_errc::invalid_time, iso8601_component::hours, 11 },
+	};
+	for (const auto& c : cases)
+	{
+		time_point<> result;
+		const auto	 error = try_parse_iso8601<extended>(c.date, result);
+		CHECK(error.code == c.code);
+		CHECK(error.component == c.component);
+		CHECK(error.offset == c.offset);
+	}
+
+	time_point<> result;
+	auto		 error = try_parse_iso8601<extended_offset>("1970-01-01T23:10:13*05:00", result);
+	CHECK(error.code == iso8601_errc::invalid_offset_sign);
+	CHECK(error.offset == 19);
+	error = try_parse_iso8601<extended_offset>("1970-01-01T23:10:13+05-00", result);
+	CHECK(error.code == iso8601_errc::missing_offset_separator);
+	CHECK(error.component == iso8601_component::timezone_offset);
+	error = try_parse_iso8601<extended_offset>("1970-01-01T23:10:13+05:15", result);
+	CHECK(error.code == iso8601_errc::invalid_timezone_offset);
+	CHECK(error.offset == 19);
+	CHECK_FALSE(try_parse_iso8601<extended_offset>("1970-01-01T23:10:13+05:45", result));
+	CHECK(result == parse_iso8601datetime("1970-01-01T23:10:13+05:45"));
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+TEST_CASE("parse_iso8601 accepts pattern strings as template arguments")
+{
+	CHECK(parse_iso8601<"YYYYMMDDThhmmss.fffZ", std::chrono::milliseconds>("20200813T231013.123Z") ==
+		  parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:13.123Z"));
+	CHECK_THROWS_AS(parse_iso8601<"YYYY-MM-DD">("2020-08-1"), iso8601_parse_error);
+
+	// the same results and errors as the tag types with the same pattern
+	for (const auto& date : generate("%04d-%02d-%02d %02d:%02d:%02d,%03d123"))
+	{
+		INFO(date);
+		CHECK(parse_iso8601<"YYYY-MM-DD hh:mm:ss,ffffff", std::chrono::microseconds>(date) ==
+			  parse_iso8601<space_delimited, std::chrono::microseconds>(date));
+	}
+	for (const char* date : { "2020-08-13T23:10:13.123456789Z", "2020-08-13T23:10:13.123456789", "2020-08-13T23:10:13,123456789Z",
+							  "2020-02-30T23:10:13.123456789Z", "2020-08-13T23:10:13.12345678Z" })
+	{
+		INFO(date);
+		time_point<std::chrono::nanoseconds> result{};
+		time_point<std::chrono::nanoseconds> expected{};
+		const auto error = try_parse_iso8601<"YYYY-MM-DDThh:mm:ss.fffffffffZ", std::chrono::nanoseconds>(date, result);
+		const auto expected_error = try_parse_iso8601<nanoseconds_utc, std::chrono::nanoseconds>(date, expected);
+		CHECK(error.code == expected_error.code);
+		CHECK(error.component == expected_error.component);
+		CHECK(error.offset == expected_error.offset);
+		CHECK(result == expected);
+	}
+
+	time_point<> result;
+	CHECK_FALSE(try_parse_iso8601<"YYYYMMDD">("20200813", result));
+	CHECK(result == parse_iso8601datetime("2020-08-13", iso8601_required::YYYYMMDD));
+	CHECK(try_parse_iso8601<"YYYYMMDD">("2020-08-13", result).code == iso8601_errc::not_a_digit);
+}
+#endif
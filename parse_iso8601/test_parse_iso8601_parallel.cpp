@@ -0,0 +1,57 @@
+#include "parse_iso8601_parallel.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+TEST_CASE("parse_iso8601datetimes_parallel returns the same values as parse_iso8601datetimes")
+{
+	const std::string_view patterns[]{ "1970-01-01T23:10:13Z", "2020-08-13T23:10:13.123Z", "19700101T231013Z",
+									   "1970-01-01T22:30:13+04:00", "1970-13-01T23:10:13Z", "1970-01-01T22:13" };
+
+	// several chunks with the last one incomplete
+	std::vector<std::string_view> dates(100003);
+	for (std::size_t i = 0; i < dates.size(); ++i)
+		dates[i] = patterns[i * 7 % std::size(patterns)];
+
+	std::vector<time_point<std::chrono::milliseconds>> expected(dates.size());
+	std::vector<std::uint8_t>						   expected_valid((dates.size() + 7) / 8);
+	parse_iso8601datetimes(dates.data(), dates.size(), expected.data(), expected_valid.data());
+
+	for (unsigned int threads : { 0u, 1u, 3u, 8u })
+	{
+		std::vector<time_point<std::chrono::milliseconds>> out(dates.size());
+		std::vector<std::uint8_t>						   valid(expected_valid.size());
+
+		const auto failures = parse_iso8601datetimes_parallel(dates.data(), dates.size(), out.data(), valid.data(),
+															  iso8601_required::YYYYMMDDhhmmss, threads);
+		CHECK(out == expected);
+		CHECK(valid == expected_valid);
+
+		// failures are reported in input order with error details
+		std::vector<std::size_t> invalid;
+		for (std::size_t i = 0; i < dates.size(); ++i)
+			if (!((valid[i / 8] >> (i % 8)) & 1))
+				invalid.push_back(i);
+		REQUIRE(failures.size() == invalid.size());
+		for (std::size_t i = 0; i < failures.size(); ++i)
+		{
+			time_point<std::chrono::milliseconds> ignored;
+			CHECK(failures[i].index == invalid[i]);
+			CHECK(failures[i].error.code == try_parse_iso8601datetime(dates[invalid[i]], ignored).code);
+		}
+		// two of six patterns are invalid, last incomplete group holds a valid one only
+		CHECK(failures.size() == dates.size() / 6 * 2);
+	}
+}
+
+TEST_CASE("parse_iso8601datetimes_parallel accepts empty input")
+{
+	CHECK(parse_iso8601datetimes_parallel<std::chrono::seconds>(nullptr, 0, nullptr, nullptr).empty());
+}
@@ -0,0 +1,137 @@
+#include "parse_iso8601.h"
+
+#include <catch2/catch.hpp>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace core::time;
+
+namespace {
+
+template <typename Duration>
+void check_same(const std::string& date, iso8601_required required, iso8601_rounding rounding)
+{
+	time_point<Duration> general{};
+	time_point<Duration> table{};
+	const auto			 general_error = detail::parse_iso8601_general(date, general, required, rounding);
+	const auto			 table_error   = detail::parse_iso8601_table(date, table, required, rounding);
+
+	INFO(date);
+	CHECK(table_error.code == general_error.code);
+	CHECK(table_error.component == general_error.component);
+	CHECK(table_error.offset == general_error.offset);
+	CHECK(table == general);
+}
+
+void check_same(const std::string& date)
+{
+	for (auto required : { iso8601_required::YYYY, iso8601_required::YYYYMMDD, iso8601_required::YYYYMMDDhhmmss })
+		check_same<std::chrono::seconds>(date, required, iso8601_rounding::truncate);
+	for (auto rounding : { iso8601_rounding::truncate, iso8601_rounding::floor, iso8601_rounding::nearest })
+	{
+		check_same<std::chrono::milliseconds>(date, iso8601_required::YYYY, rounding);
+		check_same<std::chrono::nanoseconds>(date, iso8601_required::YYYY, rounding);
+		check_same<std::chrono::minutes>(date, iso8601_required::YYYY, rounding);
+	}
+}
+
+const std::vector<std::string> samples{ "",
+										"2020",
+										"2020-08",
+										"202008",
+										"2020-08-13",
+										"20200813",
+										"2020-08-13-",
+										"2020-08-13-T23",
+										"2020-08-13T23",
+										"2020-08-13T23:10",
+										"2020-08-13T23:10:13",
+										"2020-08-13T23:10:13:",
+										"2020-08-13T23:10:13:Z",
+										"20200813T231013",
+										"20200813T2310",
+										"2020-08-13T23:10:13Z",
+										"2020-08-13T23:10:13.123456789Z",
+										"2020-08-13T23:10:13,5+01:00",
+										"2020-08-13T23.5Z",
+										"2020-08-13T23:10.25-03:30",
+										"20200813T231013.999999999999999999999-0930",
+										"2020-08-13T23:10:13\xe2\x88\x92"
+										"05:45",
+										"2020-08-13T23:10:13\xe2\x88"
+										"05:45",
+										"1970-01-01T24:00:00",
+										"2016-12-31T23:59:60Z",
+										"2020-02-29T12:00:00+14",
+										"0000-01-01T00:00:00.000001Z" };
+
+} // namespace
+
+TEST_CASE("parse_iso8601_table returns the same as parse_iso8601_general for samples")
+{
+	for (const auto& date : samples)
+		check_same(date);
+}
+
+TEST_CASE("parse_iso8601_table returns the same as parse_iso8601_general for mutated samples")
+{
+	std::mt19937 generator{ 8601 };
+	auto		 random = [&generator](std::size_t max) { return std::uniform_int_distribution<std::size_t>{ 0, max }(generator); };
+
+	// characters relevant to the grammar, including parts of utf-8 minus sign
+	const std::string alphabet{ "0123456789-:TZ+.,x \xe2\x88\x92" };
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::string date{ samples[random(samples.size() - 1)] };
+		for (std::size_t mutations = random(3); mutations > 0; --mutations)
+		{
+			const std::size_t position{ random(date.size()) };
+			const char		  ch{ alphabet[random(alphabet.size() - 1)] };
+			switch (random(3))
+			{
+			case 0:
+				if (position < date.size())
+					date[position] = ch;
+				break;
+			case 1:
+				date.insert(position, 1, ch);
+				break;
+			case 2:
+				if (position < date.size())
+					date.erase(position, 1);
+				break;
+			case 3:
+				date.resize(position);
+				break;
+			}
+		}
+		check_same(date);
+	}
+}
+
+TEST_CASE("parse_iso8601_table returns the same as parse_iso8601_general for random strings")
+{
+	std::mt19937 generator{ 8601 };
+	auto		 random = [&generator](std::size_t max) { return std::uniform_int_distribution<std::size_t>{ 0, max }(generator); };
+
+	// digits are more likely so that strings get past the year
+	const std::string alphabet{ "00112233445566778899-:TZ+.,\xe2" };
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		std::string date(random(30), ' ');
+		for (auto& ch : date)
+			ch = alphabet[random(alphabet.size() - 1)];
+		check_same(date);
+	}
+}
+
+TEST_CASE("parse_iso8601_table rejects too long input")
+{
+	time_point<> result;
+	CHECK(detail::parse_iso8601_table(std::string(65, '0'), result, iso8601_required::YYYY).code ==
+		  iso8601_errc::input_too_long);
+}
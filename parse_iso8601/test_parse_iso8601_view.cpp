@@ -0,0 +1,169 @@
+#include "iso8601_corpus.h"
+#include "parse_iso8601_view.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace core::time;
+
+#if defined(__cpp_lib_ranges)
+
+namespace {
+
+std::vector<std::string> mixed_lines()
+{
+	std::vector<std::string> lines{ "2020-08-13T23:10:13.123Z", "2020-08-13", "20200813T231013Z", "2020-08-13T24:10:13Z", "", "2020-08-13T23:10:13+01:00" };
+	for (auto kind : { iso8601_corpus_kind::fractional, iso8601_corpus_kind::offset, iso8601_corpus_kind::invalid })
+	{
+		const auto corpus = generate_iso8601_corpus(kind, 50);
+		lines.insert(lines.end(), corpus.begin(), corpus.end());
+	}
+	return lines;
+}
+
+} // namespace
+
+TEST_CASE("views::iso8601_timestamps reports the result of try_parse_iso8601datetime for each string")
+{
+	using view = iso8601_timestamps_view<std::ranges::ref_view<std::vector<std::string>>, std::chrono::milliseconds, iso8601_error_policy::report>;
+	static_assert(std::ranges::view<view>);
+	static_assert(std::ranges::forward_range<view>);
+
+	const auto	lines{ mixed_lines() };
+	std::size_t i{ 0 };
+	for (const iso8601_result<std::chrono::milliseconds> result : lines | views::iso8601_timestamps<std::chrono::milliseconds>())
+	{
+		INFO(lines[i]);
+		time_point<std::chrono::milliseconds> expected;
+		const auto							  error{ try_parse_iso8601datetime(lines[i], expected) };
+		CHECK(result.error.code == error.code);
+		CHECK(result.error.offset == error.offset);
+		CHECK(static_cast<bool>(result) == !error);
+		if (result)
+			CHECK(result.value == expected);
+		++i;
+	}
+	CHECK(i == lines.size());
+
+	std::vector<std::string_view> dates{ "2020-08-13", "2020-08-13T23:10:13Z" };
+	auto						  required = dates | views::iso8601_timestamps(iso8601_required::YYYYMMDD);
+	CHECK((*required.begin()).value == parse_iso8601datetime("2020-08-13", iso8601_required::YYYYMMDD));
+	CHECK(std::ranges::distance(required | std::views::filter([](const auto& result) { return result.has_value(); })) == 2);
+}
+
+TEST_CASE("views::iso8601_timestamps skips invalid strings by policy")
+{
+	const auto										   lines{ mixed_lines() };
+	std::vector<time_point<std::chrono::microseconds>> expected;
+	for (const auto& line : lines)
+	{
+		time_point<std::chrono::microseconds> value;
+		if (!try_parse_iso8601datetime(line, value))
+			expected.push_back(value);
+	}
+
+	std::vector<time_point<std::chrono::microseconds>> values;
+	for (auto value : lines | views::iso8601_timestamps<std::chrono::microseconds, iso8601_error_policy::skip>())
+		values.push_back(value);
+	CHECK(values == expected);
+
+	const std::vector<std::string> invalid{ "", "x", "2020-13-13T23:10:13Z" };
+	CHECK(std::ranges::empty(invalid | views::iso8601_timestamps<std::chrono::microseconds, iso8601_error_policy::skip>()));
+}
+
+TEST_CASE("views::iso8601_timestamps parses only the strings pulled")
+{
+	const std::vector<std::string> lines{ "2020-08-13T23:10:13Z", "x", "2020-08-13T23:10:14Z", "2020-08-13T23:10:15Z", "2020-08-13T23:10:16Z" };
+	std::size_t					   read{ 0 };
+	auto						   counted = lines | std::views::transform([&read](const std::string& line) {
+								 ++read;
+								 return std::string_view{ line };
+							 });
+
+	auto first = counted | views::iso8601_timestamps() | std::views::take(2);
+	for (const auto& result : first)
+		CHECK(result.has_value() == (read == 1));
+	CHECK(read == 2);
+
+	read		 = 0;
+	auto valid = counted | views::iso8601_timestamps<std::chrono::seconds, iso8601_error_policy::skip>() | std::views::take(2);
+	std::vector<time_point<std::chrono::seconds>> values;
+	for (auto value : valid)
+		values.push_back(value);
+	CHECK(values == std::vector{ parse_iso8601datetime(lines[0]), parse_iso8601datetime(lines[2]) });
+	// advancing past the second timestamp parses up to the next valid one
+	CHECK(read == 4);
+}
+
+TEST_CASE("views::iso8601_timestamps iterates a const view")
+{
+	const auto lines{ mixed_lines() };
+	const auto timestamps = lines | views::iso8601_timestamps<std::chrono::milliseconds>();
+	static_assert(std::ranges::forward_range<decltype(timestamps)>);
+
+	std::size_t valid{ 0 };
+	for (const auto result : timestamps)
+		valid += result.has_value();
+	CHECK(valid == static_cast<std::size_t>(std::ranges::count_if(lines, [](const std::string& line) { return is_valid_iso8601(line); })));
+	CHECK(std::ranges::distance(timestamps) == static_cast<std::ptrdiff_t>(lines.size()));
+
+	const auto skipped = lines | views::iso8601_timestamps<std::chrono::milliseconds, iso8601_error_policy::skip>();
+	CHECK(std::ranges::distance(skipped) == static_cast<std::ptrdiff_t>(valid));
+	CHECK(*skipped.begin() == parse_iso8601datetime<std::chrono::milliseconds>(lines[0]));
+}
+
+TEST_CASE("views::iso8601_timestamps composes with other range adaptor closures")
+{
+	const std::vector<std::string> lines{ " 2020-08-13T23:10:13Z", "x", "\t2020-08-13T23:10:14Z ", "2020-08-13T23:10:15Z", " 2020-08-13T23:10:16Z" };
+	const std::vector			   expected{ parse_iso8601datetime(lines[3]) - std::chrono::seconds{ 2 }, parse_iso8601datetime(lines[3]) - std::chrono::seconds{ 1 },
+								 parse_iso8601datetime(lines[3]), parse_iso8601datetime(lines[3]) + std::chrono::seconds{ 1 } };
+
+	const auto trim = std::views::transform([](const std::string& line) {
+		std::string_view text{ line };
+		while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+			text.remove_prefix(1);
+		while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+			text.remove_suffix(1);
+		return text;
+	});
+	const auto valid = views::iso8601_timestamps<std::chrono::seconds, iso8601_error_policy::skip>();
+
+	// chained after another closure, before being applied to a range
+	const auto parse_trimmed = trim | valid;
+	std::vector<time_point<>> values;
+	for (auto value : lines | parse_trimmed)
+		values.push_back(value);
+	CHECK(values == expected);
+
+	// followed by another closure, and by both
+	values.clear();
+	for (auto value : lines | (trim | valid | std::views::take(2)))
+		values.push_back(value);
+	CHECK(values == std::vector(expected.begin(), expected.begin() + 2));
+	CHECK(std::ranges::distance(lines | trim | (valid | std::views::drop(1))) == 3);
+
+	// and called directly
+	CHECK(std::ranges::distance(parse_trimmed(lines)) == 4);
+	CHECK(std::ranges::distance(views::iso8601_timestamps()(lines)) == static_cast<std::ptrdiff_t>(lines.size()));
+}
+
+TEST_CASE("views::iso8601_timestamps reads input ranges")
+{
+	std::istringstream stream{ "2020-08-13T23:10:13Z x 2020-08-13T23:10:14.5Z" };
+	auto			   timestamps = std::views::istream<std::string>(stream) |
+						views::iso8601_timestamps<std::chrono::milliseconds, iso8601_error_policy::skip>() |
+						std::views::filter([](auto value) { return value.time_since_epoch().count() % 1000 != 0; });
+	static_assert(!std::ranges::forward_range<decltype(timestamps)>);
+
+	std::vector<time_point<std::chrono::milliseconds>> values;
+	for (auto value : timestamps)
+		values.push_back(value);
+	CHECK(values == std::vector{ parse_iso8601datetime<std::chrono::milliseconds>("2020-08-13T23:10:14.5Z") });
+}
+
+#endif